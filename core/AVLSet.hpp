@@ -16,23 +16,54 @@
 // in your data structure.  Instead, you'll need to implement your AVL tree
 // using your own dynamically-allocated nodes, with pointers connecting them,
 // and with your own balancing algorithms used.
+//
+// Where the nodes are allocated is decided by the AVLSet's second template
+// argument, a node allocator (see NodeAllocator.hpp).  By default, each
+// node is allocated separately on the heap; an AVLSet<ElementType,
+// ArenaNodeAllocator> instead carves its nodes out of large blocks that
+// are freed all at once when the set is destroyed.
+//
+// Once an AVLSet won't change anymore, freeze() can copy it into a
+// FrozenAVLSet (see FrozenAVLSet.hpp), which stores the same elements in
+// one flat array and is faster to search.
 
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "BatchLookup.hpp"
+#include "FrozenAVLSet.hpp"
+#include "LookupKey.hpp"
+#include "NodeAllocator.hpp"
 #include "Set.hpp"
 
 
 
-template <typename ElementType>
-class AVLSet : public Set<ElementType>
+template <typename ElementType, typename NodeAllocator = HeapNodeAllocator>
+class AVLSet
+    : public Set<ElementType>,
+      public BatchLookup<typename PreferredLookupKey<ElementType>::Type>
 {
 public:
     // A VisitFunction is a function that takes a reference to a const
     // ElementType and returns no value.
     using VisitFunction = std::function<void(const ElementType&)>;
 
+    // A BatchKey is the type of the keys accepted by containsMany().
+    using BatchKey = typename PreferredLookupKey<ElementType>::Type;
+
+    // When PREFETCH_CHILDREN is true, contains() asks for both children of
+    // each node it visits to be loaded into the cache while it compares
+    // against that node, so that whichever one it moves to next is already
+    // on its way.
+    static constexpr bool PREFETCH_CHILDREN = true;
+
 public:
     // Initializes an AVLSet to be empty, with or without balancing.
     explicit AVLSet(bool shouldBalance = true);
@@ -50,10 +81,21 @@ public:
     // Assigns an existing AVLSet into another.
     AVLSet& operator=(const AVLSet& s);
 
-    // Assigns an expiring AVLSet into another.
+    // Assigns an expiring AVLSet into another.  This takes constant time,
+    // since the two sets trade their trees rather than copying them.
     AVLSet& operator=(AVLSet&& s) noexcept;
 
 
+    // fromSorted() returns an AVLSet containing the elements in the range
+    // [first, last).  When those elements are in strictly ascending order,
+    // as the words in a sorted dictionary file would be, the tree is built
+    // directly in perfectly balanced shape, in linear time and without any
+    // rotations; otherwise, the elements are added one at a time.
+    template <typename ForwardIterator>
+    static AVLSet fromSorted(
+        ForwardIterator first, ForwardIterator last, bool shouldBalance = true);
+
+
     // isImplemented() should be modified to return true if you've
     // decided to implement an AVLSet, false otherwise.
     bool isImplemented() const noexcept override;
@@ -67,16 +109,43 @@ public:
 
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function always runs in O(log n) time when
-    // there are n elements in the AVL tree.
+    // there are n elements in the AVL tree, comparing the element against
+    // each node on its way down only once.
     bool contains(const ElementType& element) const override;
 
 
+    // These versions of contains() look for a lookup key (such as a
+    // std::string_view, or a pointer to characters and a length, in a set
+    // of std::strings), comparing it against the elements directly rather
+    // than building an ElementType from it first.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<ElementType, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
+    // containsMany() sets found[i] to whether keys[i] is in the set, for
+    // each i less than count.  It searches for a group of keys at once,
+    // taking one step down the tree for each key in turn and prefetching
+    // the node that key will visit next, so the cache misses of all the
+    // keys in a group overlap instead of happening one after another.
+    void containsMany(const BatchKey* keys, unsigned int count, bool* found) const override;
+
+
+    // looksUpKeysDirectly() returns true, since keys are only compared
+    // with elements, never turned into them.
+    bool looksUpKeysDirectly() const noexcept override;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
 
     // height() returns the height of the AVL tree.  Note that, by definition,
-    // the height of an empty tree is -1.
+    // the height of an empty tree is -1.  Every node keeps track of the
+    // height of its own subtree, so this function runs in constant time.
     int height() const noexcept;
 
 
@@ -97,6 +166,11 @@ public:
     // tree.
     void postorder(VisitFunction visit) const;
 
+
+    // freeze() returns an immutable copy of the set, whose elements are
+    // stored in one array rather than in nodes.  The AVLSet is unchanged.
+    FrozenAVLSet<ElementType> freeze() const;
+
     
 
 
@@ -109,19 +183,29 @@ private:
             ElementType elem;
             Node * left = nullptr;
             Node * right = nullptr;
+            int height = 0;
         };
     Node * root = nullptr;
+    NodeAllocator allocator;
+    template <typename... Args>
+    Node * newNode(Args&&... args);
+    void deleteNode(Node * node) noexcept;
     void copyTreeRec( Node * &first, const Node * second);
+    template <typename ForwardIterator>
+    Node * buildSortedRec(ForwardIterator& next, unsigned int count);
     void deleteTreeRec(Node * treeroot);
-    bool containshelper(const ElementType& element, Node* const&treeroot) const;
-    int heighthelper(Node *treeroot) const;
+    void deleteAll() noexcept;
+    template <typename KeyType>
+    bool containshelper(const KeyType& element, Node* const&treeroot) const;
+    static int heightOf(const Node * treeroot) noexcept;
+    static void updateHeight(Node * treeroot) noexcept;
     int needToBalance(Node * treeroot) const; 
     Node * addhelper(const ElementType& element, Node *& treeroot);
     void LL(Node *& treeroot); 
     void RR(Node *& treeroot); 
     void LR(Node *& treeroot); 
     void RL(Node *& treeroot); 
-    void balancing(Node *& treeroot,const ElementType& element);
+    void balancing(Node *& treeroot);
     bool shouldBalance = true;
 
     void preorderhelper(VisitFunction visit, Node *treeroot) const;
@@ -130,63 +214,77 @@ private:
 };
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(bool shouldBalance)
+template <typename ElementType, typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::AVLSet(bool shouldBalance)
 {
     iSize = 0;
     root = nullptr;
     this->shouldBalance = shouldBalance;
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::deleteTreeRec(Node* treeroot)
+template <typename ElementType, typename NodeAllocator>
+template <typename... Args>
+typename AVLSet<ElementType, NodeAllocator>::Node * AVLSet<ElementType, NodeAllocator>::newNode(Args&&... args)
+{
+    void * memory = allocator.allocate(sizeof(Node));
+    try
+    {
+        return new (memory) Node{std::forward<Args>(args)...};
+    }
+    catch (...)
+    {
+        allocator.deallocate(memory, sizeof(Node));
+        throw;
+    }
+}
+
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::deleteNode(Node * node) noexcept
+{
+    node->~Node();
+    allocator.deallocate(node, sizeof(Node));
+}
+
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::deleteTreeRec(Node* treeroot)
 {
     if(treeroot) 
     {
         deleteTreeRec(treeroot->right);
         deleteTreeRec(treeroot->left);
-        delete treeroot;
+        deleteNode(treeroot);
     }   
 }
 
-template <typename ElementType>
-AVLSet<ElementType>::~AVLSet() noexcept
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::deleteAll() noexcept
 {
-    deleteTreeRec(root);
+    //when the allocator is about to free every node's memory anyway, and
+    //there are no destructors to run, there's no need to visit the nodes
+    if constexpr (!NodeAllocator::RELEASES_ALL_AT_ONCE || !std::is_trivially_destructible_v<Node>)
+        deleteTreeRec(root);
+    allocator.reset();
+    root = nullptr;
+}
+
+template <typename ElementType, typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::~AVLSet() noexcept
+{
+    deleteAll();
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::copyTreeRec(Node* &first, const Node* second) 
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::copyTreeRec(Node* &first, const Node* second) 
 {
     //if original is not null
     if(second != nullptr) 
     {
-        //create a new node for the current root node;
-        first = new Node{second->elem};
-        //if there is a left
-        if (second->left)
-        {
-            //create a new node, link it with my copy and recurse down the tree
-            Node * leftnode = new Node{second->left->elem};
-            first->left = leftnode;
-            copyTreeRec(first->left,second->left);
-        }
-        else
-            //point to null othersise
-            first->left = nullptr;
-        
-        //if right exists
-        if (second -> right) 
-        {
-            //create a new node, link to copy and recurse down the tree
-            Node * rightnode = new Node{second->right->elem};
-            first->right = rightnode;
-            copyTreeRec(first->right,second->right);
-        }
-        else 
-            //else point to null
-            first->right = nullptr;  
+        //create a new node for the current root node, then recurse down
+        //the tree to create its children
+        first = newNode(second->elem, nullptr, nullptr, second->height);
+        copyTreeRec(first->left,second->left);
+        copyTreeRec(first->right,second->right);
     }  
     else
     {
@@ -196,148 +294,215 @@ void AVLSet<ElementType>::copyTreeRec(Node* &first, const Node* second)
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(const AVLSet& s)
+template <typename ElementType, typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::AVLSet(const AVLSet& s)
+    : iSize{s.iSize}, shouldBalance{s.shouldBalance}
 {
     copyTreeRec(root,s.root);
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(AVLSet&& s) noexcept
-    : root{nullptr}
+template <typename ElementType, typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::AVLSet(AVLSet&& s) noexcept
+    : root{nullptr}, allocator{std::move(s.allocator)}
 {
     iSize = s.iSize;
     root = s.root;
+    shouldBalance = s.shouldBalance;
     s.iSize = 0;
     s.root = nullptr;
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>& AVLSet<ElementType>::operator=(const AVLSet& s)
+template <typename ElementType, typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>& AVLSet<ElementType, NodeAllocator>::operator=(const AVLSet& s)
 {
-    deleteTreeRec(root);
-    root = nullptr;
-    copyTreeRec(root,s.root);
+    if(this != &s)
+    {
+        deleteAll();
+        copyTreeRec(root,s.root);
+        iSize = s.iSize;
+        shouldBalance = s.shouldBalance;
+    }
     return *this;
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>& AVLSet<ElementType>::operator=(AVLSet&& s) noexcept
+template <typename ElementType, typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>& AVLSet<ElementType, NodeAllocator>::operator=(AVLSet&& s) noexcept
 {
-    if(this != &s)
+    //trade trees with s rather than copying its tree, so this takes
+    //constant time; our old nodes (and the allocator they came from) are
+    //destroyed along with s
+    std::swap(root, s.root);
+    std::swap(iSize, s.iSize);
+    std::swap(shouldBalance, s.shouldBalance);
+    std::swap(allocator, s.allocator);
+    return *this;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+template <typename ForwardIterator>
+AVLSet<ElementType, NodeAllocator> AVLSet<ElementType, NodeAllocator>::fromSorted(
+    ForwardIterator first, ForwardIterator last, bool shouldBalance)
+{
+    AVLSet s{shouldBalance};
+
+    unsigned int count = 0;
+    bool sorted = true;
+    for (ForwardIterator i = first, previous = first; i != last; previous = i, ++i)
     {
-        deleteTreeRec(root);
-        root = nullptr;
-        copyTreeRec(root,s.root);
+        if (count > 0 && impl_::compareKeys(*previous, *i) >= 0)
+        {
+            sorted = false;
+            break;
+        }
+        count++;
     }
-    return *this;
+
+    if (sorted)
+    {
+        s.root = s.buildSortedRec(first, count);
+        s.iSize = count;
+    }
+    else
+    {
+        for (; first != last; ++first)
+            s.add(*first);
+    }
+
+    return s;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+template <typename ForwardIterator>
+typename AVLSet<ElementType, NodeAllocator>::Node * AVLSet<ElementType, NodeAllocator>::buildSortedRec(ForwardIterator& next, unsigned int count)
+{
+    //the first half of the remaining elements form the left subtree, the
+    //middle one is the root, and the rest form the right subtree
+    if (count == 0)
+        return nullptr;
+
+    Node * left = buildSortedRec(next, count / 2);
+    Node * treeroot = newNode(*next, left, nullptr);
+    ++next;
+    treeroot->right = buildSortedRec(next, count - count / 2 - 1);
+    updateHeight(treeroot);
+    return treeroot;
 }
 
 
-template <typename ElementType>
-bool AVLSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename NodeAllocator>
+bool AVLSet<ElementType, NodeAllocator>::isImplemented() const noexcept
 {
     return true;
 }
 
 
-template <typename ElementType>
-int AVLSet<ElementType>::needToBalance(Node * treeroot) const 
+template <typename ElementType, typename NodeAllocator>
+int AVLSet<ElementType, NodeAllocator>::heightOf(const Node * treeroot) noexcept
+{
+    return treeroot != nullptr ? treeroot->height : -1;
+}
+
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::updateHeight(Node * treeroot) noexcept
+{
+    int l = heightOf(treeroot->left);
+    int r = heightOf(treeroot->right);
+    treeroot->height = (l > r ? l : r) + 1;
+}
+
+template <typename ElementType, typename NodeAllocator>
+int AVLSet<ElementType, NodeAllocator>::needToBalance(Node * treeroot) const 
 {
-    int balval = heighthelper(treeroot->left) - heighthelper(treeroot->right);
+    int balval = heightOf(treeroot->left) - heightOf(treeroot->right);
     return balval;
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::LL(Node *& treeroot) 
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::LL(Node *& treeroot) 
 {
     Node * t = treeroot -> left;
     treeroot->left = t->right;
     t -> right = treeroot;
+    updateHeight(treeroot);
+    updateHeight(t);
     treeroot = t;
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::RR(Node *& treeroot) 
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::RR(Node *& treeroot) 
 {
     Node * t = treeroot -> right;
     treeroot->right = t->left;
     t -> left = treeroot;
+    updateHeight(treeroot);
+    updateHeight(t);
     treeroot = t;
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::LR(Node *& treeroot) 
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::LR(Node *& treeroot) 
 {
-    LL(treeroot->left);
-    RR(treeroot);
+    RR(treeroot->left);
+    LL(treeroot);
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::RL(Node *& treeroot) 
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::RL(Node *& treeroot) 
 {
-    RR(treeroot->right);
-    LL(treeroot);
+    LL(treeroot->right);
+    RR(treeroot);
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::balancing(Node *& treeroot, const ElementType& element) 
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::balancing(Node *& treeroot) 
 {
-    
-    if (needToBalance(treeroot) > 1 && element < treeroot->left->elem)
-        LL(treeroot);
-    else if (needToBalance(treeroot) < -1 && element > treeroot->right->elem)
-        RR(treeroot);
-    else if (needToBalance(treeroot) > 1 && (element > treeroot->left->elem))
-        {
-        RR(treeroot->left);
-        LL(treeroot);
-        }
-    else if(needToBalance(treeroot) < -1 &&  element < treeroot->right->elem)
+    // The children's own balance decides between a single and a double
+    // rotation, which saves comparing the new element all over again.
+    int balval = needToBalance(treeroot);
+    if (balval > 1)
+    {
+        if (needToBalance(treeroot->left) >= 0)
+            LL(treeroot);
+        else
+            LR(treeroot);
+    }
+    else if (balval < -1)
     {
-        LL(treeroot->right);
-        RR(treeroot);
+        if (needToBalance(treeroot->right) <= 0)
+            RR(treeroot);
+        else
+            RL(treeroot);
     }
 }
 
-template <typename ElementType>
-typename AVLSet<ElementType>::Node * AVLSet<ElementType>::addhelper(const ElementType& element, Node *& treeroot)
+template <typename ElementType, typename NodeAllocator>
+typename AVLSet<ElementType, NodeAllocator>::Node * AVLSet<ElementType, NodeAllocator>::addhelper(const ElementType& element, Node *& treeroot)
 {
     //add a value
     if (treeroot != nullptr)
     {
-        if (element < treeroot->elem)
-        {
+        int cmp = impl_::compareKeys(element, treeroot->elem);
+        if (cmp < 0)
             treeroot->left = addhelper(element, treeroot->left);
-            if(shouldBalance ==true) 
-            {
-                if(needToBalance(treeroot))
-                {
-                    balancing(treeroot, element);
-                }
-            }
-        }
-        else if (element > treeroot->elem)
-        {
+        else if (cmp > 0)
             treeroot->right = addhelper(element, treeroot->right);
-            if(shouldBalance == true) 
-            {
-                if(needToBalance(treeroot))
-                {
-                    balancing(treeroot, element);
-                }
-            }
-        }
+        else
+            return treeroot;
+
+        updateHeight(treeroot);
+        if(shouldBalance == true)
+            balancing(treeroot);
         return treeroot;
     }
     else 
     {
         iSize++;
-        Node * newNode = new Node{element,nullptr,nullptr};
-        treeroot = newNode;
+        treeroot = newNode(element,nullptr,nullptr);
         return treeroot;
     }
 
@@ -346,73 +511,127 @@ typename AVLSet<ElementType>::Node * AVLSet<ElementType>::addhelper(const Elemen
 
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::add(const ElementType& element)
 {
     //iSize++;
     addhelper(element,root);
     //balancing(root,element);
 }
 
-template <typename ElementType>
-bool AVLSet<ElementType>::containshelper(const ElementType &element,  Node*const& treeroot) const
+template <typename ElementType, typename NodeAllocator>
+template <typename KeyType>
+bool AVLSet<ElementType, NodeAllocator>::containshelper(const KeyType &element,  Node*const& treeroot) const
 {
-    if (treeroot == nullptr)
-        return false;
-    else
+    for (Node * node = treeroot; node != nullptr; )
     {
-        if(element == treeroot->elem)
-            return true;
-        else if (element > treeroot->elem)
-            return containshelper(element,treeroot->right);
-        else
-            return containshelper(element, treeroot->left);
+        if constexpr (PREFETCH_CHILDREN)
+        {
+            impl_::prefetch(node->left);
+            impl_::prefetch(node->right);
+        }
 
+        int cmp = impl_::compareKeys(element, node->elem);
+        if (cmp == 0)
+            return true;
+        node = cmp < 0 ? node->left : node->right;
     }
+    return false;
 }
 
 
-template <typename ElementType>
-bool AVLSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename NodeAllocator>
+bool AVLSet<ElementType, NodeAllocator>::contains(const ElementType& element) const
 {
     return containshelper(element,root);
 }
 
 
-template <typename ElementType>
-unsigned int AVLSet<ElementType>::size() const noexcept
+template <typename ElementType, typename NodeAllocator>
+template <typename KeyType, typename>
+bool AVLSet<ElementType, NodeAllocator>::contains(const KeyType& key) const
 {
-    return iSize;
+    return containshelper(key,root);
 }
 
 
+template <typename ElementType, typename NodeAllocator>
+bool AVLSet<ElementType, NodeAllocator>::contains(const char* chars, std::size_t length) const
+{
+    return contains(std::string_view{chars, length});
+}
 
-template <typename ElementType>
-int AVLSet<ElementType>::heighthelper(Node * treeroot) const
+
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::containsMany(const BatchKey* keys, unsigned int count, bool* found) const
 {
-    if (treeroot != nullptr)
+    constexpr unsigned int GROUP_SIZE = 8;
+    Node * nodes[GROUP_SIZE];
+
+    for (unsigned int start = 0; start < count; start += GROUP_SIZE)
     {
-        int l = heighthelper(treeroot -> left);
-        int r = heighthelper(treeroot -> right);
+        unsigned int n = std::min(GROUP_SIZE, count - start);
+        for (unsigned int i = 0; i < n; i++)
+        {
+            nodes[i] = root;
+            found[start + i] = false;
+        }
 
-        if (l > r)
-            return (l+1);
-        else    
-            return (r + 1);
+        for (unsigned int searching = n; searching > 0; )
+        {
+            searching = 0;
+            for (unsigned int i = 0; i < n; i++)
+            {
+                Node * node = nodes[i];
+                if (node == nullptr)
+                    continue;
+
+                int cmp = impl_::compareKeys(keys[start + i], node->elem);
+                if (cmp == 0)
+                {
+                    found[start + i] = true;
+                    node = nullptr;
+                }
+                else if (cmp < 0)
+                    node = node->left;
+                else
+                    node = node->right;
+
+                nodes[i] = node;
+                if (node)
+                {
+                    impl_::prefetch(node);
+                    searching++;
+                }
+            }
+        }
     }
-    else
-        return -1;
 }
 
 
-template <typename ElementType>
-int AVLSet<ElementType>::height() const noexcept
+template <typename ElementType, typename NodeAllocator>
+bool AVLSet<ElementType, NodeAllocator>::looksUpKeysDirectly() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+unsigned int AVLSet<ElementType, NodeAllocator>::size() const noexcept
+{
+    return iSize;
+}
+
+
+
+template <typename ElementType, typename NodeAllocator>
+int AVLSet<ElementType, NodeAllocator>::height() const noexcept
 {
-    return heighthelper(root);
+    return heightOf(root);
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::preorderhelper(VisitFunction visit, Node *treeroot) const
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::preorderhelper(VisitFunction visit, Node *treeroot) const
 {
     if (treeroot)
     {
@@ -422,15 +641,15 @@ void AVLSet<ElementType>::preorderhelper(VisitFunction visit, Node *treeroot) co
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::preorder(VisitFunction visit) const
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::preorder(VisitFunction visit) const
 {
     preorderhelper(visit,root);
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::inorderhelper(VisitFunction visit, Node *treeroot) const
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::inorderhelper(VisitFunction visit, Node *treeroot) const
 {
     if (treeroot)
     {
@@ -440,14 +659,22 @@ void AVLSet<ElementType>::inorderhelper(VisitFunction visit, Node *treeroot) con
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::inorder(VisitFunction visit) const
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::inorder(VisitFunction visit) const
 {
     inorderhelper(visit,root);
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::postorderhelper(VisitFunction visit, Node *treeroot) const
+template <typename ElementType, typename NodeAllocator>
+FrozenAVLSet<ElementType> AVLSet<ElementType, NodeAllocator>::freeze() const
+{
+    FrozenAVLSet<ElementType> frozen{size()};
+    inorderhelper([&](const ElementType& element) { frozen.append(element); }, root);
+    return frozen;
+}
+
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::postorderhelper(VisitFunction visit, Node *treeroot) const
 {
     if (treeroot)
     {
@@ -458,8 +685,8 @@ void AVLSet<ElementType>::postorderhelper(VisitFunction visit, Node *treeroot) c
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::postorder(VisitFunction visit) const
+template <typename ElementType, typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::postorder(VisitFunction visit) const
 {
     postorderhelper(visit,root);
 }
@@ -0,0 +1,117 @@
+// BKTree.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "BKTree.hpp"
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include "EditDistance.hpp"
+
+
+void BKTree::add(const std::string& word)
+{
+    unsigned int index = static_cast<unsigned int>(nodes.size());
+
+    if (nodes.empty())
+    {
+        nodes.push_back(Node{word, 0, 1, NONE, NONE});
+        treeHeight = 1;
+        return;
+    }
+
+    unsigned int current = 0;
+    while (true)
+    {
+        unsigned int d = damerauLevenshteinDistance(word, nodes[current].word);
+        if (d == 0)
+            return;
+
+        unsigned int child = nodes[current].firstChild;
+        while (child != NONE && nodes[child].distance != d)
+            child = nodes[child].nextSibling;
+
+        if (child == NONE)
+        {
+            unsigned int depth = nodes[current].depth + 1;
+            nodes.push_back(Node{word, d, depth, NONE, nodes[current].firstChild});
+            nodes[current].firstChild = index;
+            treeHeight = std::max(treeHeight, depth);
+            return;
+        }
+
+        current = child;
+    }
+}
+
+
+unsigned int BKTree::size() const noexcept
+{
+    return static_cast<unsigned int>(nodes.size());
+}
+
+
+unsigned int BKTree::height() const noexcept
+{
+    return treeHeight;
+}
+
+
+unsigned int BKTree::maxDistance() const noexcept
+{
+    return UNBOUNDED;
+}
+
+
+std::vector<std::string> BKTree::suggestions(
+    const std::string& word, unsigned int maxDistance) const
+{
+    unsigned int measured;
+    return suggestions(word, maxDistance, measured);
+}
+
+
+std::vector<std::string> BKTree::suggestions(
+    const std::string& word, unsigned int maxDistance, unsigned int& measured) const
+{
+    measured = 0;
+    if (nodes.empty())
+        return {};
+
+    // maxDistance can be UNBOUNDED, so it's clamped to keep d + maxDistance
+    // below from overflowing.  d is never more than the longer word's
+    // length, so the sum fits for any words shorter than the clamp.
+    maxDistance = std::min(maxDistance, std::numeric_limits<unsigned int>::max() / 2);
+
+    std::vector<std::pair<unsigned int, std::string_view>> found;
+    std::vector<unsigned int> pending{0};
+
+    while (!pending.empty())
+    {
+        const Node& node = nodes[pending.back()];
+        pending.pop_back();
+
+        unsigned int d = damerauLevenshteinDistance(word, node.word);
+        measured++;
+
+        if (d != 0 && d <= maxDistance)
+        {
+            unsigned int exact = editDistance(word, node.word, maxDistance);
+            if (exact <= maxDistance)
+                found.emplace_back(exact, node.word);
+        }
+
+        unsigned int low = d > maxDistance ? d - maxDistance : 0;
+        unsigned int high = d + maxDistance;
+
+        for (unsigned int child = node.firstChild; child != NONE; child = nodes[child].nextSibling)
+        {
+            if (nodes[child].distance >= low && nodes[child].distance <= high)
+                pending.push_back(child);
+        }
+    }
+
+    return nearestFirst(std::move(found));
+}
@@ -0,0 +1,99 @@
+// BKTree.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BKTree (Burkhard-Keller tree) is a SuggestionIndex that arranges words
+// by their distances from one another, so that a search can rule out
+// whole groups of words without measuring how far away they are.
+//
+// Each node holds one word, and each of its children is labeled with the
+// distance between that child's word and the node's; no two children of
+// a node have the same label.  Adding a word means measuring its distance
+// from the root's word, following the child with that label, and so on,
+// until there's no such child, at which point the word becomes one.
+//
+// Searching for the words within k of some word w, starting at the root:
+// if the distance from w to the node's word is d, then that word is a
+// match if d is at most k, and, because distance is a metric, every word
+// under a child labeled j is at least |d - j| away from w, so only the
+// children labeled d - k through d + k need to be searched.  For k = 1
+// that's three children out of what are often dozens, which prunes most
+// of the tree; as k grows, the range widens, and pruning fades.
+//
+// The distance the tree is arranged by is damerauLevenshteinDistance(),
+// since editDistance() isn't quite a metric.  The former is never larger
+// than the latter, so searching by it finds every word that's close enough
+// by editDistance(), after which the few that aren't are discarded.
+//
+// Nodes are stored in a vector, indexed by the order their words were
+// added, with each node's children in a singly-linked list through it.
+
+#ifndef BKTREE_HPP
+#define BKTREE_HPP
+
+#include <string>
+#include <vector>
+#include "SuggestionIndex.hpp"
+
+
+
+class BKTree : public SuggestionIndex
+{
+public:
+    BKTree() = default;
+
+    ~BKTree() noexcept override = default;
+
+
+    // add() adds a word to the tree, if it isn't already there.
+    void add(const std::string& word);
+
+
+    // size() returns the number of distinct words in the tree.
+    unsigned int size() const noexcept;
+
+
+    // height() returns the number of nodes on the longest path from the
+    // root to a leaf, or 0 if the tree is empty.
+    unsigned int height() const noexcept;
+
+
+    // A BKTree can search any distance, though its advantage over
+    // measuring the distance to every word shrinks as the distance grows,
+    // so maxDistance() returns UNBOUNDED.
+    unsigned int maxDistance() const noexcept override;
+
+
+    std::vector<std::string> suggestions(
+        const std::string& word, unsigned int maxDistance) const override;
+
+
+    // This version of suggestions() also stores, in measured, how many of
+    // the tree's words it measured the distance to, which shows how much
+    // of the tree the search was able to rule out.
+    std::vector<std::string> suggestions(
+        const std::string& word, unsigned int maxDistance, unsigned int& measured) const;
+
+
+private:
+    static constexpr unsigned int NONE = static_cast<unsigned int>(-1);
+
+    struct Node
+    {
+        std::string word;
+        unsigned int distance;
+        unsigned int depth;
+        unsigned int firstChild;
+        unsigned int nextSibling;
+    };
+
+
+private:
+    std::vector<Node> nodes;
+    unsigned int treeHeight = 0;
+};
+
+
+
+#endif
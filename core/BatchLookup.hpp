@@ -0,0 +1,80 @@
+// BatchLookup.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BatchLookup is a set that can look up many keys in one call.  Looking
+// keys up one at a time means waiting for each one's memory accesses to
+// finish before the next one can start; given all of them at once, a set
+// can instead start fetching the memory for every key before it examines
+// any of them, so that the waiting overlaps.
+//
+// Sets inherit from BatchLookup in addition to Set, using the type that
+// PreferredLookupKey chooses for their ElementType as the key type, so a
+// caller holding only a reference to a Set can find out whether batching
+// is available by trying a dynamic_cast.
+
+#ifndef BATCHLOOKUP_HPP
+#define BATCHLOOKUP_HPP
+
+#include <string>
+#include <string_view>
+
+
+
+template <typename KeyType>
+class BatchLookup
+{
+public:
+    virtual ~BatchLookup() = default;
+
+    // containsMany() sets found[i] to true if keys[i] is in the set, or
+    // false otherwise, for every i that is less than count.
+    virtual void containsMany(const KeyType* keys, unsigned int count, bool* found) const = 0;
+
+    // looksUpKeysDirectly() returns true if containsMany() can look up a
+    // key as it is.  A set whose hash function only accepts its own
+    // ElementType has to build an element from each key first, which can
+    // cost more than batching saves.
+    virtual bool looksUpKeysDirectly() const noexcept = 0;
+};
+
+
+
+// PreferredLookupKey<ElementType>::Type is the key type that a set of
+// ElementType accepts in containsMany(): a std::string_view for a set of
+// std::strings, so that callers don't have to build strings, or else
+// ElementType itself.
+
+template <typename ElementType>
+struct PreferredLookupKey
+{
+    using Type = ElementType;
+};
+
+
+template <>
+struct PreferredLookupKey<std::string>
+{
+    using Type = std::string_view;
+};
+
+
+
+namespace impl_
+{
+    // prefetch() asks the processor to start loading the memory at the
+    // given address into the cache, without waiting for it to arrive.
+    inline void prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+}
+
+
+
+#endif
@@ -0,0 +1,440 @@
+// ConcurrentHashSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentHashSet is a hash table that any number of threads can add
+// elements to and search at the same time, which makes it possible to
+// build one large set (such as a dictionary merged from several word
+// lists) using every core at once.
+//
+// The table is split into a fixed number of shards, each of which is an
+// independent, open-addressed hash table (using linear probing) with its
+// own lock.  An element's shard is chosen by the high bits of its hash
+// value (after multiplying it by a large odd constant, so that even a
+// hash function whose high bits are all the same spreads the elements
+// across the shards), while the low bits choose its cell within the
+// shard, so the two choices are independent of one another.  Threads
+// adding elements to different shards never contend with each other.
+//
+// Searching never takes a lock.  Each cell of a shard's table holds an
+// atomic pointer to an entry containing an element and its hash value;
+// a new entry is built completely before the pointer to it is stored in
+// its cell, so a search that sees the pointer sees the whole entry.
+// When a shard grows, its entries are placed into a new, larger table,
+// which then replaces the old one.  Searches that were already looking
+// at the old table may still be, so it isn't freed until the whole set
+// is destroyed; since each table is twice as large as the one before it,
+// all of a shard's old tables together are never larger than its current
+// one.  (Entries are never removed, since there's no way to remove an
+// element from a Set, so they're likewise freed only by the destructor.)
+//
+// Each shard's table grows, doubling in size, whenever it's more than 80%
+// full.  A ConcurrentHashSet can't be copied or moved, since doing so
+// wouldn't be safe while other threads might be using it.
+
+#ifndef CONCURRENTHASHSET_HPP
+#define CONCURRENTHASHSET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "LookupKey.hpp"
+#include "Set.hpp"
+
+
+
+template <typename ElementType, typename HashFunctionType = std::function<unsigned int(const ElementType&)>>
+class ConcurrentHashSet : public Set<ElementType>
+{
+public:
+    // The type of the hash function this set uses.  By default, it's a
+    // std::function, as in HashSet; any function object type that can be
+    // called with a const ElementType& and returns unsigned int can be
+    // given instead.
+    using HashFunction = HashFunctionType;
+
+    // The number of shards a ConcurrentHashSet has unless told otherwise,
+    // which is comfortably more than the number of threads that are likely
+    // to be adding elements at once.
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 64;
+
+public:
+    // Initializes a ConcurrentHashSet to be empty, with the given number
+    // of shards (rounded up to a power of two).
+    explicit ConcurrentHashSet(
+        HashFunction hashFunction, unsigned int shardCount = DEFAULT_SHARD_COUNT);
+
+    // Cleans up the ConcurrentHashSet so that it leaks no memory.
+    ~ConcurrentHashSet() noexcept override;
+
+    ConcurrentHashSet(const ConcurrentHashSet& s) = delete;
+    ConcurrentHashSet(ConcurrentHashSet&& s) = delete;
+    ConcurrentHashSet& operator=(const ConcurrentHashSet& s) = delete;
+    ConcurrentHashSet& operator=(ConcurrentHashSet&& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set (or another thread adds it at the same time), this function has
+    // no effect.  It's safe to call add() and contains() from any number
+    // of threads at once.
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It never waits for a lock.  An element being added by
+    // another thread at the same time may or may not be found.
+    bool contains(const ElementType& element) const override;
+
+
+    // These versions of contains() look for a lookup key (such as a
+    // std::string_view, or a pointer to characters and a length, in a set
+    // of std::strings), comparing it against the elements directly rather
+    // than building an ElementType from it first.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<ElementType, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding elements, it reflects some of those additions
+    // but not necessarily all of them.
+    unsigned int size() const noexcept override;
+
+
+    // shardCount() returns the number of shards.
+    unsigned int shardCount() const noexcept;
+
+
+    // elementsInShard() returns the number of elements stored in the given
+    // shard, and capacityOfShard() the number of cells in its table.  If
+    // the given shard doesn't exist, both return 0.
+    unsigned int elementsInShard(unsigned int shard) const noexcept;
+    unsigned int capacityOfShard(unsigned int shard) const noexcept;
+
+
+    // elementsAtIndex() returns the number of elements in the given shard
+    // that hashed to a particular index in its table, and isElementAtIndex()
+    // returns true if the given element is in the given shard and hashed to
+    // that index, as HashSet's functions of the same names do for its one
+    // array.  If the shard doesn't exist, or the index is out of the
+    // boundaries of its table, they return 0 and false.  While other
+    // threads are adding elements, their results reflect some of those
+    // additions but not necessarily all of them.
+    unsigned int elementsAtIndex(unsigned int shard, unsigned int index) const noexcept;
+    bool isElementAtIndex(const ElementType& element, unsigned int shard, unsigned int index) const;
+
+
+private:
+    struct Entry
+    {
+        ElementType element;
+        unsigned int hash;
+    };
+
+    // A Table is one shard's array of cells.  It points to the table it
+    // replaced, if any, so that table can be freed along with this one.
+    struct Table
+    {
+        unsigned int cap;
+        std::atomic<Entry*>* cells;
+        Table* previous;
+    };
+
+    // Shards are aligned to cache lines, so that threads adding to
+    // neighboring shards don't slow each other down.
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::atomic<Table*> table{nullptr};
+        std::atomic<unsigned int> count{0};
+    };
+
+    static constexpr unsigned int INITIAL_SHARD_CAPACITY = 16;
+
+    static Table* newTable(unsigned int cap, Table* previous);
+    void grow(Shard& shard);
+    unsigned int shardFor(unsigned int hashval) const noexcept;
+
+    template <typename KeyType>
+    unsigned int hashKey(const KeyType& key) const;
+
+    template <typename KeyType>
+    bool containshelper(const KeyType& key, unsigned int hashval) const;
+
+private:
+    HashFunction hashFunction;
+    Shard* shards;
+    unsigned int shardBits;
+};
+
+
+
+template <typename ElementType, typename HashFunctionType>
+ConcurrentHashSet<ElementType, HashFunctionType>::ConcurrentHashSet(
+    HashFunction hashFunction, unsigned int shardCount)
+    : hashFunction{std::move(hashFunction)}, shardBits{0}
+{
+    while ((1u << shardBits) < shardCount && shardBits < 16)
+        shardBits++;
+
+    shards = new Shard[1u << shardBits];
+    for (unsigned int i = 0; i < (1u << shardBits); i++)
+        shards[i].table.store(newTable(INITIAL_SHARD_CAPACITY, nullptr), std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+ConcurrentHashSet<ElementType, HashFunctionType>::~ConcurrentHashSet() noexcept
+{
+    for (unsigned int i = 0; i < (1u << shardBits); i++)
+    {
+        Table* table = shards[i].table.load(std::memory_order_relaxed);
+
+        //every entry is in the newest table
+        for (unsigned int j = 0; j < table->cap; j++)
+            delete table->cells[j].load(std::memory_order_relaxed);
+
+        while (table)
+        {
+            Table* previous = table->previous;
+            delete[] table->cells;
+            delete table;
+            table = previous;
+        }
+    }
+
+    delete[] shards;
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+typename ConcurrentHashSet<ElementType, HashFunctionType>::Table* ConcurrentHashSet<ElementType, HashFunctionType>::newTable(
+    unsigned int cap, Table* previous)
+{
+    return new Table{cap, new std::atomic<Entry*>[cap](), previous};
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::shardFor(unsigned int hashval) const noexcept
+{
+    if (shardBits == 0)
+        return 0;
+
+    return (hashval * 0x9E3779B9u) >> (32 - shardBits);
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+template <typename KeyType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::hashKey(const KeyType& key) const
+{
+    // A hash function that only accepts ElementType (such as the default
+    // std::function) leaves us no choice but to build one.
+    if constexpr (std::is_invocable_v<const HashFunction&, const KeyType&>)
+        return hashFunction(key);
+    else
+        return hashFunction(ElementType{key});
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+bool ConcurrentHashSet<ElementType, HashFunctionType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+void ConcurrentHashSet<ElementType, HashFunctionType>::grow(Shard& shard)
+{
+    //the entries are only moved, not copied, and since we hold the shard's
+    //lock, nothing else can be changing the old table while we do
+    Table* old = shard.table.load(std::memory_order_relaxed);
+    Table* table = newTable(old->cap * 2, old);
+    unsigned int mask = table->cap - 1;
+
+    for (unsigned int i = 0; i < old->cap; i++)
+    {
+        Entry* entry = old->cells[i].load(std::memory_order_relaxed);
+        if (entry)
+        {
+            unsigned int index = entry->hash & mask;
+            while (table->cells[index].load(std::memory_order_relaxed))
+                index = (index + 1) & mask;
+            table->cells[index].store(entry, std::memory_order_relaxed);
+        }
+    }
+
+    shard.table.store(table, std::memory_order_release);
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+void ConcurrentHashSet<ElementType, HashFunctionType>::add(const ElementType& element)
+{
+    unsigned int hashval = hashFunction(element);
+    Shard& shard = shards[shardFor(hashval)];
+
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    Table* table = shard.table.load(std::memory_order_relaxed);
+    unsigned int mask = table->cap - 1;
+    unsigned int index = hashval & mask;
+
+    while (Entry* entry = table->cells[index].load(std::memory_order_relaxed))
+    {
+        if (entry->hash == hashval && entry->element == element)
+            return;
+        index = (index + 1) & mask;
+    }
+
+    unsigned int count = shard.count.load(std::memory_order_relaxed);
+    if (table->cap * 0.8 < count + 1)
+    {
+        grow(shard);
+        table = shard.table.load(std::memory_order_relaxed);
+        mask = table->cap - 1;
+        index = hashval & mask;
+        while (table->cells[index].load(std::memory_order_relaxed))
+            index = (index + 1) & mask;
+    }
+
+    table->cells[index].store(new Entry{element, hashval}, std::memory_order_release);
+    shard.count.store(count + 1, std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+template <typename KeyType>
+bool ConcurrentHashSet<ElementType, HashFunctionType>::containshelper(
+    const KeyType& key, unsigned int hashval) const
+{
+    const Table* table = shards[shardFor(hashval)].table.load(std::memory_order_acquire);
+    unsigned int mask = table->cap - 1;
+
+    for (unsigned int index = hashval & mask; ; index = (index + 1) & mask)
+    {
+        const Entry* entry = table->cells[index].load(std::memory_order_acquire);
+        if (!entry)
+            return false;
+        else if (entry->hash == hashval && entry->element == key)
+            return true;
+    }
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+bool ConcurrentHashSet<ElementType, HashFunctionType>::contains(const ElementType& element) const
+{
+    return containshelper(element, hashFunction(element));
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+template <typename KeyType, typename>
+bool ConcurrentHashSet<ElementType, HashFunctionType>::contains(const KeyType& key) const
+{
+    return containshelper(key, hashKey(key));
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+bool ConcurrentHashSet<ElementType, HashFunctionType>::contains(const char* chars, std::size_t length) const
+{
+    return contains(std::string_view{chars, length});
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::size() const noexcept
+{
+    unsigned int total = 0;
+    for (unsigned int i = 0; i < (1u << shardBits); i++)
+        total += shards[i].count.load(std::memory_order_relaxed);
+    return total;
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::shardCount() const noexcept
+{
+    return 1u << shardBits;
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::elementsInShard(unsigned int shard) const noexcept
+{
+    if (shard >= shardCount())
+        return 0;
+
+    return shards[shard].count.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::capacityOfShard(unsigned int shard) const noexcept
+{
+    if (shard >= shardCount())
+        return 0;
+
+    return shards[shard].table.load(std::memory_order_acquire)->cap;
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int ConcurrentHashSet<ElementType, HashFunctionType>::elementsAtIndex(
+    unsigned int shard, unsigned int index) const noexcept
+{
+    if (shard >= shardCount())
+        return 0;
+
+    const Table* table = shards[shard].table.load(std::memory_order_acquire);
+    if (index >= table->cap)
+        return 0;
+
+    //everything that hashed to this index sits in the unbroken run of
+    //occupied cells that starts there
+    unsigned int mask = table->cap - 1;
+    unsigned int count = 0;
+    for (unsigned int i = index; ; i = (i + 1) & mask)
+    {
+        const Entry* entry = table->cells[i].load(std::memory_order_acquire);
+        if (!entry)
+            return count;
+        else if ((entry->hash & mask) == index)
+            count++;
+    }
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+bool ConcurrentHashSet<ElementType, HashFunctionType>::isElementAtIndex(
+    const ElementType& element, unsigned int shard, unsigned int index) const
+{
+    if (shard >= shardCount())
+        return false;
+
+    unsigned int hashval = hashFunction(element);
+    if (shardFor(hashval) != shard)
+        return false;
+
+    const Table* table = shards[shard].table.load(std::memory_order_acquire);
+    return index < table->cap && (hashval & (table->cap - 1)) == index && containshelper(element, hashval);
+}
+
+
+
+#endif
@@ -0,0 +1,486 @@
+// ConcurrentSkipListSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentSkipListSet is a skip list, laid out the same way as a
+// SkipListSet (one node per element, ending in an array of forward
+// pointers), that any number of threads can add elements to and search
+// at the same time.  It's lock-free: no thread ever waits for a lock, and
+// a thread that's stalled partway through an add() can't keep any other
+// thread from finishing its own.
+//
+//   * contains() never waits or retries.  It follows the same path a
+//     SkipListSet search would, reading each forward pointer atomically.
+//
+//   * add() links a new node into each of its levels, from the bottom up,
+//     with a compare-and-swap on the forward pointer of the node it's
+//     being placed after.  If another thread changed that pointer first,
+//     the search for the new node's position is simply repeated.  Once a
+//     node is linked into level 0, it's in the set; linking it into the
+//     levels above that only makes it quicker to find.
+//
+//   * Level testers aren't written to be used by multiple threads at
+//     once, so the level tester given to the constructor is only used as
+//     a prototype.  The first time a thread adds an element, it makes its
+//     own clone() of the prototype and keeps it for the rest of the set's
+//     lifetime; after that, it asks only its own clone how many levels a
+//     new element should occupy.  (clone() may therefore be called by
+//     several threads at once, so it mustn't change the prototype.)  Each
+//     thread remembers which clone it used last, and for which set, so
+//     finding it again doesn't usually mean searching through all of them.
+//
+// Since there's no way to remove an element from a Set, a node is never
+// unlinked once it's been published, so nothing that a search might be
+// looking at is ever freed while the set is alive.  That makes safe
+// memory reclamation (hazard pointers, epochs, and so on) unnecessary;
+// every node is freed by the destructor, when no other thread can be
+// using the set.
+//
+// For the same reason that copying or moving a set that other threads
+// may be using would be unsafe, a ConcurrentSkipListSet can't be copied
+// or moved.
+
+#ifndef CONCURRENTSKIPLISTSET_HPP
+#define CONCURRENTSKIPLISTSET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "LookupKey.hpp"
+#include "Set.hpp"
+#include "SkipListSet.hpp"
+
+
+
+template <typename ElementType>
+class ConcurrentSkipListSet : public Set<ElementType>
+{
+public:
+    // MAX_LEVELS is the most levels that a skip list can have.
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+public:
+    // Initializes a ConcurrentSkipListSet to be empty, with or without a
+    // "level tester" object that will decide, whenever a "coin flip"
+    // is needed, whether a key should occupy the next level above.
+    ConcurrentSkipListSet();
+    explicit ConcurrentSkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester);
+
+    // Cleans up the ConcurrentSkipListSet so that it leaks no memory.
+    ~ConcurrentSkipListSet() noexcept override;
+
+    ConcurrentSkipListSet(const ConcurrentSkipListSet& s) = delete;
+    ConcurrentSkipListSet(ConcurrentSkipListSet&& s) = delete;
+    ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet& s) = delete;
+    ConcurrentSkipListSet& operator=(ConcurrentSkipListSet&& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set (or another thread adds it at the same time), this function has
+    // no effect.  It's safe to call add() and contains() from any number
+    // of threads at once.
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  An element being added by another thread at the same
+    // time may or may not be found.
+    bool contains(const ElementType& element) const override;
+
+
+    // These versions of contains() look for a lookup key (such as a
+    // std::string_view, or a pointer to characters and a length, in a set
+    // of std::strings), comparing it against the elements directly rather
+    // than building an ElementType from it first.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<ElementType, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // levelCount() returns the number of levels in the skip list.
+    unsigned int levelCount() const noexcept;
+
+
+    // elementsOnLevel() and isElementOnLevel() behave the same as they do
+    // in a SkipListSet.  While other threads are adding elements, their
+    // results reflect some of those additions but not necessarily all.
+    unsigned int elementsOnLevel(unsigned int level) const noexcept;
+    bool isElementOnLevel(const ElementType& element, unsigned int level) const;
+
+
+private:
+    using Node = impl_::SkipListNode<ElementType, true>;
+
+    static Node* newNode(SkipListKind kind, unsigned int levels, const ElementType* element = nullptr);
+    static void deleteNode(Node* node) noexcept;
+    unsigned int chooseLevels(const ElementType& element);
+
+    // A LevelTesterSlot holds the clone of the level tester that belongs
+    // to one thread.  Slots are only ever added to the front of the list,
+    // and never removed until the set is destroyed, so the list holds one
+    // slot for every thread that has ever added to the set.  Searching it
+    // takes time proportional to that, so each thread caches the last
+    // slot it used, along with the id of the set it belongs to, and only
+    // searches the list when it's using a different set than last time.
+    // (Ids, unlike addresses, are never reused by another set, so a cached
+    // slot can't be mistaken for one of a set that replaced its own.)
+    struct LevelTesterSlot
+    {
+        std::thread::id owner;
+        std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
+        LevelTesterSlot* next;
+    };
+
+    // findhelper() fills in, for each level, the last node whose key is
+    // smaller than the given one (before) and the node after it (after).
+    // It returns true if the given key is in the set.
+    template <typename KeyType>
+    bool findhelper(const KeyType& key, Node** before, Node** after) const;
+
+    // containshelper() returns the node containing the given key, or
+    // nullptr if there isn't one.
+    template <typename KeyType>
+    Node* containshelper(const KeyType& key) const;
+
+private:
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
+    std::atomic<LevelTesterSlot*> levelTesterSlots{nullptr};
+    std::uint64_t id;
+
+    Node* head;
+    Node* tail;
+    std::atomic<unsigned int> iSize{0};
+    std::atomic<unsigned int> levels{1};
+};
+
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::ConcurrentSkipListSet()
+    : ConcurrentSkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()}
+{
+}
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::ConcurrentSkipListSet(
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+    : levelTester{std::move(levelTester)}
+{
+    //ids start at 1, so a thread's empty cache doesn't match any set
+    static std::atomic<std::uint64_t> nextId{1};
+    id = nextId.fetch_add(1, std::memory_order_relaxed);
+
+    head = newNode(SkipListKind::NegInf, MAX_LEVELS);
+    tail = newNode(SkipListKind::PosInf, 0);
+
+    for (unsigned int level = 0; level < MAX_LEVELS; level++)
+        head->next()[level].store(tail, std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::newNode(
+    SkipListKind kind, unsigned int levels, const ElementType* element)
+{
+    void* memory = ::operator new(Node::bytesFor(levels));
+    try
+    {
+        return Node::create(memory, kind, levels, element);
+    }
+    catch (...)
+    {
+        ::operator delete(memory);
+        throw;
+    }
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::deleteNode(Node* node) noexcept
+{
+    node->destroy();
+    ::operator delete(node);
+}
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::~ConcurrentSkipListSet() noexcept
+{
+    //every node, including both sentinels, is on level 0
+    Node* node = head;
+    while (node)
+    {
+        Node* next = node != tail ? node->next()[0].load(std::memory_order_relaxed) : nullptr;
+        deleteNode(node);
+        node = next;
+    }
+
+    LevelTesterSlot* slot = levelTesterSlots.load(std::memory_order_relaxed);
+    while (slot)
+    {
+        LevelTesterSlot* next = slot->next;
+        delete slot;
+        slot = next;
+    }
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::chooseLevels(const ElementType& element)
+{
+    struct LevelTesterCache
+    {
+        std::uint64_t setId = 0;
+        LevelTesterSlot* slot = nullptr;
+    };
+
+    static thread_local LevelTesterCache cache;
+    if (cache.setId == id)
+        return cache.slot->levelTester->levelsFor(element, MAX_LEVELS);
+
+    std::thread::id self = std::this_thread::get_id();
+    LevelTesterSlot* first = levelTesterSlots.load(std::memory_order_acquire);
+
+    for (LevelTesterSlot* slot = first; slot; slot = slot->next)
+    {
+        if (slot->owner == self)
+        {
+            cache = LevelTesterCache{id, slot};
+            return slot->levelTester->levelsFor(element, MAX_LEVELS);
+        }
+    }
+
+    //only this thread ever adds a slot it owns, so if the compare-and-swap
+    //fails, the slots other threads added in the meantime needn't be
+    //searched again
+    LevelTesterSlot* slot = new LevelTesterSlot{self, levelTester->clone(), first};
+    while (!levelTesterSlots.compare_exchange_weak(
+        slot->next, slot, std::memory_order_release, std::memory_order_acquire))
+    {
+    }
+
+    cache = LevelTesterCache{id, slot};
+    return slot->levelTester->levelsFor(element, MAX_LEVELS);
+}
+
+
+template <typename ElementType>
+template <typename KeyType>
+bool ConcurrentSkipListSet<ElementType>::findhelper(const KeyType& key, Node** before, Node** after) const
+{
+    //levels above the highest one in use have nothing but the sentinels
+    //on them, as far as we know; if another thread is adding a node that
+    //high, our compare-and-swap on the head will notice
+    unsigned int top = levels.load(std::memory_order_acquire);
+    for (unsigned int level = top; level < MAX_LEVELS; level++)
+    {
+        before[level] = head;
+        after[level] = head->next()[level].load(std::memory_order_acquire);
+    }
+
+    Node* node = head;
+    for (unsigned int level = top; level-- > 0; )
+    {
+        Node* next = node->next()[level].load(std::memory_order_acquire);
+        while (next->key().compare(key) < 0)
+        {
+            node = next;
+            next = node->next()[level].load(std::memory_order_acquire);
+        }
+
+        before[level] = node;
+        after[level] = next;
+    }
+
+    return after[0]->key().compare(key) == 0;
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::add(const ElementType& element)
+{
+    Node* before[MAX_LEVELS];
+    Node* after[MAX_LEVELS];
+
+    if (findhelper(element, before, after))
+        return;
+
+    unsigned int nodeLevels = chooseLevels(element);
+    Node* added = newNode(SkipListKind::Normal, nodeLevels, &element);
+
+    //raise the level count first, so searches that start after the node
+    //is linked in on its upper levels will use them
+    unsigned int top = levels.load(std::memory_order_relaxed);
+    while (top < nodeLevels
+        && !levels.compare_exchange_weak(top, nodeLevels, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+
+    //linking the node into level 0 is what adds it to the set; if some
+    //other thread adds the same element first, ours was never visible to
+    //anyone, so it can simply be thrown away
+    while (true)
+    {
+        added->next()[0].store(after[0], std::memory_order_relaxed);
+        if (before[0]->next()[0].compare_exchange_strong(
+                after[0], added, std::memory_order_release, std::memory_order_relaxed))
+        {
+            break;
+        }
+
+        if (findhelper(element, before, after))
+        {
+            deleteNode(added);
+            return;
+        }
+    }
+
+    iSize.fetch_add(1, std::memory_order_relaxed);
+
+    for (unsigned int level = 1; level < nodeLevels; level++)
+    {
+        while (true)
+        {
+            added->next()[level].store(after[level], std::memory_order_relaxed);
+            if (before[level]->next()[level].compare_exchange_strong(
+                    after[level], added, std::memory_order_release, std::memory_order_relaxed))
+            {
+                break;
+            }
+
+            findhelper(element, before, after);
+        }
+    }
+}
+
+
+template <typename ElementType>
+template <typename KeyType>
+typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::containshelper(
+    const KeyType& key) const
+{
+    Node* node = head;
+    for (unsigned int level = levels.load(std::memory_order_acquire); level-- > 0; )
+    {
+        Node* next = node->next()[level].load(std::memory_order_acquire);
+        int comparison;
+
+        while ((comparison = next->key().compare(key)) < 0)
+        {
+            node = next;
+            next = node->next()[level].load(std::memory_order_acquire);
+        }
+
+        if (comparison == 0)
+            return next;
+    }
+
+    return nullptr;
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::contains(const ElementType& element) const
+{
+    return containshelper(element) != nullptr;
+}
+
+
+template <typename ElementType>
+template <typename KeyType, typename>
+bool ConcurrentSkipListSet<ElementType>::contains(const KeyType& key) const
+{
+    return containshelper(key) != nullptr;
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::contains(const char* chars, std::size_t length) const
+{
+    return contains(std::string_view{chars, length});
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::size() const noexcept
+{
+    return iSize.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::levelCount() const noexcept
+{
+    return levels.load(std::memory_order_acquire);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+{
+    if (level >= MAX_LEVELS)
+        return 0;
+
+    unsigned int count = 0;
+    for (Node* node = head->next()[level].load(std::memory_order_acquire);
+         node != tail;
+         node = node->next()[level].load(std::memory_order_acquire))
+    {
+        count++;
+    }
+    return count;
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+{
+    //the element is on the given level if a search finds it on that level
+    //or any level above it, so there's no need to look below it
+    Node* node = head;
+    for (unsigned int current = MAX_LEVELS; current-- > level; )
+    {
+        Node* next = node->next()[current].load(std::memory_order_acquire);
+        int comparison;
+
+        while ((comparison = next->key().compare(element)) < 0)
+        {
+            node = next;
+            next = node->next()[current].load(std::memory_order_acquire);
+        }
+
+        if (comparison == 0)
+            return true;
+    }
+
+    return false;
+}
+
+
+
+#endif
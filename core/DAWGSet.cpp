@@ -0,0 +1,465 @@
+// DAWGSet.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "DAWGSet.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+
+namespace
+{
+    // Registers start with this many cells, and are kept at least twice
+    // as large as the number of states in them, so that there's always
+    // an empty cell to stop at.
+    constexpr std::size_t INITIAL_REGISTER_SIZE = 1024;
+
+
+    std::size_t commonPrefixLength(const std::string& a, const std::string& b)
+    {
+        std::size_t n = std::min(a.size(), b.size());
+        std::size_t i = 0;
+        while (i < n && a[i] == b[i])
+            i++;
+        return i;
+    }
+}
+
+
+DAWGSet::DAWGSet()
+{
+    clear();
+}
+
+
+DAWGSet::DAWGSet(std::vector<std::string> words)
+{
+    clear();
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    for (const std::string& word : words)
+        add(word);
+}
+
+
+bool DAWGSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void DAWGSet::add(const std::string& element)
+{
+    if (count > 0)
+    {
+        int comparison = element.compare(previous);
+        if (comparison == 0)
+            return;
+        else if (comparison < 0)
+        {
+            if (!contains(element))
+                rebuildWith(element);
+            return;
+        }
+    }
+
+    if (path.size() != previous.size() + 1)
+        thaw();
+
+    // Everything along the previous word past the prefix it shares with
+    // this one is finished, and the rest of this word becomes the path.
+    std::size_t common = commonPrefixLength(element, previous);
+    freezeFrom(common);
+
+    for (std::size_t i = common; i < element.size(); i++)
+    {
+        path.back().edges.push_back(Edge{NONE, element[i], i + 1 == element.size(), false});
+        path.emplace_back();
+    }
+
+    if (element.empty())
+        rootFinal = true;
+
+    previous = element;
+    count++;
+}
+
+
+bool DAWGSet::contains(const std::string& element) const
+{
+    return contains(element.data(), element.size());
+}
+
+
+bool DAWGSet::contains(const char* chars, std::size_t length) const
+{
+    return containsFrom(root(), chars, length);
+}
+
+
+DAWGSet::Position DAWGSet::root() const noexcept
+{
+    return Position{NONE, 0, rootFinal};
+}
+
+
+bool DAWGSet::advance(Position& position, char label) const noexcept
+{
+    // Following the last transition out of a state on the path leads to
+    // the next state on the path; any other leads into the array.
+    if (position.depth != NONE)
+    {
+        const std::vector<Edge>& out = path[position.depth].edges;
+
+        for (std::size_t i = 0; i < out.size(); i++)
+        {
+            if (out[i].label == label)
+            {
+                if (i + 1 == out.size() && position.depth + 1 < path.size())
+                    position = Position{NONE, position.depth + 1, out[i].final};
+                else
+                    position = Position{out[i].target, NONE, out[i].final};
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    const Edge* edge = findEdge(position.state, label);
+    if (edge == nullptr)
+        return false;
+
+    position = Position{edge->target, NONE, edge->final};
+    return true;
+}
+
+
+bool DAWGSet::containsFrom(Position position, const char* chars, std::size_t length) const noexcept
+{
+    for (std::size_t i = 0; i < length; i++)
+    {
+        if (!advance(position, chars[i]))
+            return false;
+    }
+
+    return position.final;
+}
+
+
+unsigned int DAWGSet::size() const noexcept
+{
+    return count;
+}
+
+
+unsigned int DAWGSet::stateCount() const noexcept
+{
+    // Every frozen state with transitions has exactly one marked last.  The
+    // last state on the path has no transitions; once it's frozen, it's
+    // the one state without them, which isn't stored anywhere.
+    unsigned int frozen = static_cast<unsigned int>(
+        std::count_if(edges.begin(), edges.end(), [](const Edge& e) { return e.last; }));
+
+    unsigned int leaf = path.size() < previous.size() + 1 ? 1 : 0;
+
+    return frozen + static_cast<unsigned int>(path.size()) + leaf;
+}
+
+
+unsigned int DAWGSet::transitionCount() const noexcept
+{
+    std::size_t transitions = edges.size();
+    for (const PathState& state : path)
+        transitions += state.edges.size();
+
+    return static_cast<unsigned int>(transitions);
+}
+
+
+std::size_t DAWGSet::memoryUsage() const noexcept
+{
+    std::size_t bytes =
+        edges.capacity() * sizeof(Edge)
+        + registry.capacity() * sizeof(unsigned int)
+        + path.capacity() * sizeof(PathState)
+        + previous.capacity();
+
+    for (const PathState& state : path)
+        bytes += state.edges.capacity() * sizeof(Edge);
+
+    return bytes;
+}
+
+
+void DAWGSet::compact()
+{
+    freezeFrom(0);
+    path.shrink_to_fit();
+
+    edges.shrink_to_fit();
+    registry.clear();
+    registry.shrink_to_fit();
+    registered = 0;
+    registryValid = false;
+}
+
+
+void DAWGSet::clear()
+{
+    edges.clear();
+    path.assign(1, PathState{});
+    registry.clear();
+    registered = 0;
+    registryValid = true;
+    previous.clear();
+    rootFinal = false;
+    count = 0;
+}
+
+
+void DAWGSet::rebuildWith(const std::string& element)
+{
+    std::vector<std::string> words;
+    words.reserve(count + 1);
+
+    std::string word;
+    auto collect = [&](const std::string& w) { words.push_back(w); };
+
+    if (rootFinal)
+        collect(word);
+
+    visitPath(0, word, collect);
+
+    words.insert(std::upper_bound(words.begin(), words.end(), element), element);
+
+    clear();
+    for (const std::string& w : words)
+        add(w);
+}
+
+
+void DAWGSet::freezeFrom(std::size_t depth)
+{
+    while (path.size() > depth + 1)
+    {
+        unsigned int state = freeze(path.back().edges);
+        path.pop_back();
+        path.back().edges.back().target = state;
+    }
+}
+
+
+void DAWGSet::thaw()
+{
+    for (std::size_t i = path.size() - 1; i < previous.size(); i++)
+    {
+        unsigned int state = path[i].edges.back().target;
+        path.emplace_back();
+
+        for (std::size_t j = state; state != NONE; j++)
+        {
+            path.back().edges.push_back(edges[j]);
+            path.back().edges.back().last = false;
+
+            if (edges[j].last)
+                break;
+        }
+    }
+}
+
+
+unsigned int DAWGSet::freeze(const std::vector<Edge>& out)
+{
+    if (out.empty())
+        return NONE;
+
+    if (!registryValid)
+        rebuildRegister();
+
+    // The state is appended to the array first, so that it can be compared
+    // with registered states in place; if one of them is the same, it's
+    // removed again.
+    unsigned int state = static_cast<unsigned int>(edges.size());
+    edges.insert(edges.end(), out.begin(), out.end());
+    edges.back().last = true;
+
+    return registerState(state);
+}
+
+
+unsigned int DAWGSet::registerState(unsigned int state)
+{
+    if (registry.size() < 2 * (static_cast<std::size_t>(registered) + 1))
+    {
+        std::vector<unsigned int> states;
+        states.reserve(registered);
+        for (unsigned int s : registry)
+        {
+            if (s != NONE)
+                states.push_back(s);
+        }
+
+        fillRegister(states);
+    }
+
+    std::size_t mask = registry.size() - 1;
+    for (std::size_t i = hashState(state) & mask; ; i = (i + 1) & mask)
+    {
+        if (registry[i] == NONE)
+        {
+            registry[i] = state;
+            registered++;
+            return state;
+        }
+        else if (sameState(registry[i], state))
+        {
+            edges.resize(state);
+            return registry[i];
+        }
+    }
+}
+
+
+void DAWGSet::rebuildRegister()
+{
+    // Every state in the array is already distinct from the others, so
+    // they can all be registered without comparing any of them.
+    std::vector<unsigned int> states;
+    std::size_t start = 0;
+
+    for (std::size_t i = 0; i < edges.size(); i++)
+    {
+        if (edges[i].last)
+        {
+            states.push_back(static_cast<unsigned int>(start));
+            start = i + 1;
+        }
+    }
+
+    fillRegister(states);
+    registryValid = true;
+}
+
+
+void DAWGSet::fillRegister(const std::vector<unsigned int>& states)
+{
+    std::size_t size = INITIAL_REGISTER_SIZE;
+    while (size < 2 * (states.size() + 1))
+        size *= 2;
+
+    registry.assign(size, NONE);
+    registered = static_cast<unsigned int>(states.size());
+
+    std::size_t mask = size - 1;
+    for (unsigned int state : states)
+    {
+        std::size_t i = hashState(state) & mask;
+        while (registry[i] != NONE)
+            i = (i + 1) & mask;
+        registry[i] = state;
+    }
+}
+
+
+std::size_t DAWGSet::hashState(unsigned int state) const noexcept
+{
+    std::uint64_t h = 0x9E3779B97F4A7C15ull;
+
+    for (std::size_t i = state; ; i++)
+    {
+        const Edge& e = edges[i];
+        std::uint64_t bits =
+            (static_cast<std::uint64_t>(e.target) << 16)
+            | (static_cast<std::uint64_t>(static_cast<unsigned char>(e.label)) << 1)
+            | (e.final ? 1 : 0);
+
+        h = (h ^ bits) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+
+        if (e.last)
+            break;
+    }
+
+    return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+
+bool DAWGSet::sameState(unsigned int a, unsigned int b) const noexcept
+{
+    for (std::size_t i = a, j = b; ; i++, j++)
+    {
+        const Edge& x = edges[i];
+        const Edge& y = edges[j];
+
+        if (x.target != y.target || x.label != y.label || x.final != y.final || x.last != y.last)
+            return false;
+        else if (x.last)
+            return true;
+    }
+}
+
+
+const DAWGSet::Edge* DAWGSet::findEdge(unsigned int state, char label) const noexcept
+{
+    if (state == NONE)
+        return nullptr;
+
+    for (std::size_t i = state; ; i++)
+    {
+        const Edge& e = edges[i];
+        if (e.label == label)
+            return &e;
+        else if (e.last)
+            return nullptr;
+    }
+}
+
+
+template <typename VisitFunction>
+void DAWGSet::visitPath(std::size_t depth, std::string& word, VisitFunction& visit) const
+{
+    const std::vector<Edge>& out = path[depth].edges;
+
+    for (std::size_t i = 0; i < out.size(); i++)
+    {
+        word.push_back(out[i].label);
+
+        if (out[i].final)
+            visit(word);
+
+        if (i + 1 == out.size() && depth + 1 < path.size())
+            visitPath(depth + 1, word, visit);
+        else if (out[i].target != NONE)
+            visitFrozen(out[i].target, word, visit);
+
+        word.pop_back();
+    }
+}
+
+
+template <typename VisitFunction>
+void DAWGSet::visitFrozen(unsigned int state, std::string& word, VisitFunction& visit) const
+{
+    for (std::size_t i = state; ; i++)
+    {
+        const Edge& e = edges[i];
+        word.push_back(e.label);
+
+        if (e.final)
+            visit(word);
+
+        if (e.target != NONE)
+            visitFrozen(e.target, word, visit);
+
+        word.pop_back();
+
+        if (e.last)
+            break;
+    }
+}
@@ -0,0 +1,269 @@
+// DAWGSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A DAWGSet is a set of strings stored as a minimal directed acyclic word
+// graph (DAWG): a trie in which every group of identical subtrees has been
+// merged into one.  Words in a dictionary share a great deal -- not only
+// prefixes, which any trie shares, but suffixes like "ING", "ATION", and
+// "S" -- so the graph has far fewer states and transitions than the words
+// have characters, and storing it takes several times less memory than
+// storing each word as a separate std::string in a HashSet or AVLSet.
+//
+// A word is in the set if, starting from the root, there's a transition
+// labeled with each of its characters in turn, and the last one leads to a
+// final state.  Each transition is stored as an eight-byte Edge holding
+// its label, the index of its target state, whether that target is final,
+// and whether it's the last transition out of its state.  The transitions
+// out of each state are stored next to each other, in order by label, in
+// one array, so a state is just the index of its first transition.
+//
+// The graph is built with the incremental algorithm of Daciuk, Mihov,
+// Watson, and Watson, which requires words to be added in sorted order.
+// Each word shares some prefix with the previous one; the states along the
+// rest of the previous word can't gain any more transitions, so they're
+// "frozen": from the deepest up, each is looked up in a register of the
+// states frozen so far, and if an identical one (with the same
+// transitions to the same states) is found, that one is used instead.
+// Only the states along the most recently added word are still being
+// built, so only they are stored separately, as a short "path" of small
+// vectors; searches start along the path and move into the array as soon
+// as they leave it.
+//
+// Adding a word that comes before the previous one (or removing any,
+// which a Set never does) can change frozen states, so an out-of-order
+// add() lists every word, inserts the new one, and builds the graph over
+// again.  That's fine for an occasional word, but loading an unsorted
+// dictionary that way takes quadratic time, so the constructor that takes
+// a vector of words sorts them first.
+//
+// Beyond contains(), a DAWGSet can be searched a character at a time,
+// starting from root() and following transitions with advance(), which
+// lets a search that's building up a word abandon it as soon as the prefix
+// built so far leads nowhere, rather than finishing it and looking it up.
+// WordChecker searches this way for suggestions when given a DAWGSet.
+//
+// Once every word has been added, compact() freezes the states along the
+// path, too, so that the graph is minimal, and releases the register (an
+// open-addressed table of state indexes) and any spare capacity in the
+// array, none of which are needed for searching.  Words can still be added
+// afterward: since the most recently added word is the largest, the
+// transitions it follows are always the last out of each state, so its
+// states can be copied back out of the array onto the path, and the
+// register can be rebuilt from the array.  The copies they're made from
+// are left in the array, though, so compacting between adds wastes space.
+
+#ifndef DAWGSET_HPP
+#define DAWGSET_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "LookupKey.hpp"
+#include "Set.hpp"
+
+
+
+class DAWGSet : public Set<std::string>
+{
+public:
+    // Initializes a DAWGSet to be empty.
+    DAWGSet();
+
+    // Initializes a DAWGSet to contain the given words, which can be in
+    // any order and can contain duplicates.
+    explicit DAWGSet(std::vector<std::string> words);
+
+    ~DAWGSet() noexcept override = default;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in
+    // the set, this function has no effect.  Adding words in sorted order
+    // takes time proportional to the length of each word; adding a word
+    // that comes before the most recently added one rebuilds the set.
+    void add(const std::string& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise, in time proportional to the element's length.
+    bool contains(const std::string& element) const override;
+
+
+    // These versions of contains() look for a std::string_view, or a
+    // pointer to characters and a length, without building a std::string.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<std::string, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
+    // A Position is the state that a search has reached after following
+    // the transitions for the characters of some prefix, where final is
+    // true if that prefix is a word in the set.  Adding words to the set
+    // invalidates every Position in it.
+    struct Position
+    {
+        unsigned int state;
+        unsigned int depth;
+        bool final;
+    };
+
+
+    // root() returns the Position of the empty prefix.
+    Position root() const noexcept;
+
+
+    // advance() follows the transition labeled with the given character
+    // from the given Position, returning false (and leaving the Position
+    // unchanged) if there isn't one, which means that no word in the set
+    // begins with the prefix plus that character.
+    bool advance(Position& position, char label) const noexcept;
+
+
+    // containsFrom() returns true if following the given characters from
+    // the given Position leads to a word.
+    bool containsFrom(Position position, const char* chars, std::size_t length) const noexcept;
+
+
+    // forEachTransition() calls visit(label, next) for each transition out
+    // of the given Position, in order by label, where next is the Position
+    // that the transition leads to.
+    template <typename VisitFunction>
+    void forEachTransition(const Position& position, VisitFunction visit) const;
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // stateCount() and transitionCount() return the number of states and
+    // transitions in the graph, which, for a dictionary, are much smaller
+    // than the total length of its words.  Until compact() is called, the
+    // states along the most recently added word haven't been merged with
+    // others yet, so they're counted separately.
+    unsigned int stateCount() const noexcept;
+
+    unsigned int transitionCount() const noexcept;
+
+
+    // memoryUsage() returns the number of bytes of memory the set has
+    // allocated, not counting the DAWGSet object itself.
+    std::size_t memoryUsage() const noexcept;
+
+
+    // compact() finishes merging states and releases the memory that's
+    // only needed while adding words.  The set can still have words added
+    // to it afterward.
+    void compact();
+
+
+private:
+    static constexpr unsigned int NONE = static_cast<unsigned int>(-1);
+
+    struct Edge
+    {
+        unsigned int target;
+        char label;
+        bool final;
+        bool last;
+    };
+
+    struct PathState
+    {
+        std::vector<Edge> edges;
+    };
+
+    void clear();
+    void rebuildWith(const std::string& element);
+
+    void freezeFrom(std::size_t depth);
+    void thaw();
+    unsigned int freeze(const std::vector<Edge>& out);
+
+    unsigned int registerState(unsigned int state);
+    void rebuildRegister();
+    void fillRegister(const std::vector<unsigned int>& states);
+    std::size_t hashState(unsigned int state) const noexcept;
+    bool sameState(unsigned int a, unsigned int b) const noexcept;
+
+    const Edge* findEdge(unsigned int state, char label) const noexcept;
+
+    template <typename VisitFunction>
+    void visitPath(std::size_t depth, std::string& word, VisitFunction& visit) const;
+
+    template <typename VisitFunction>
+    void visitFrozen(unsigned int state, std::string& word, VisitFunction& visit) const;
+
+
+private:
+    // Frozen states' transitions, where a state is the index of its first.
+    // A transition to a state with no transitions out of it has a target
+    // of NONE.
+    std::vector<Edge> edges;
+
+    // The states along the most recently added word, starting with the
+    // root, where the last transition out of each one (except the last)
+    // leads to the next one; the targets of those transitions are set
+    // only when the next one is frozen.  After compact(), only the root
+    // is left.
+    std::vector<PathState> path;
+
+    // The register of frozen states, where empty cells hold NONE.
+    std::vector<unsigned int> registry;
+    unsigned int registered;
+    bool registryValid;
+
+    std::string previous;
+    bool rootFinal;
+    unsigned int count;
+};
+
+
+
+template <typename KeyType, typename>
+bool DAWGSet::contains(const KeyType& key) const
+{
+    std::string_view view{key};
+    return contains(view.data(), view.size());
+}
+
+
+template <typename VisitFunction>
+void DAWGSet::forEachTransition(const Position& position, VisitFunction visit) const
+{
+    if (position.depth != NONE)
+    {
+        const std::vector<Edge>& out = path[position.depth].edges;
+
+        for (std::size_t i = 0; i < out.size(); i++)
+        {
+            if (i + 1 == out.size() && position.depth + 1 < path.size())
+                visit(out[i].label, Position{NONE, position.depth + 1, out[i].final});
+            else
+                visit(out[i].label, Position{out[i].target, NONE, out[i].final});
+        }
+    }
+    else if (position.state != NONE)
+    {
+        for (std::size_t i = position.state; ; i++)
+        {
+            const Edge& e = edges[i];
+            visit(e.label, Position{e.target, NONE, e.final});
+
+            if (e.last)
+                break;
+        }
+    }
+}
+
+
+
+#endif
@@ -0,0 +1,158 @@
+// DeletionIndex.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "DeletionIndex.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include "EditDistance.hpp"
+#include "StringHash.hpp"
+
+
+namespace
+{
+    // deletionsOf() returns every distinct string that can be made by
+    // deleting no more than maxDistance characters from the given word,
+    // including the word itself.  Each round deletes one more character
+    // from each string the previous round made; deleting different
+    // characters often leaves the same string (as with either 'S' in
+    // "MISS"), so each round is sorted and stripped of duplicates before
+    // the next one starts from it.
+    std::vector<std::string> deletionsOf(std::string_view word, unsigned int maxDistance)
+    {
+        std::vector<std::string> all{std::string{word}};
+        std::size_t roundStart = 0;
+
+        for (unsigned int round = 1; round <= maxDistance; round++)
+        {
+            std::size_t roundEnd = all.size();
+            std::vector<std::string> next;
+
+            for (std::size_t i = roundStart; i < roundEnd; i++)
+            {
+                const std::string& s = all[i];
+                for (std::size_t j = 0; j < s.size(); j++)
+                {
+                    std::string deleted = s;
+                    deleted.erase(j, 1);
+                    next.push_back(std::move(deleted));
+                }
+            }
+
+            if (next.empty())
+                break;
+
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+
+            roundStart = roundEnd;
+            for (std::string& s : next)
+                all.push_back(std::move(s));
+        }
+
+        return all;
+    }
+}
+
+
+DeletionIndex::DeletionIndex(unsigned int maxDistance)
+    : distance{maxDistance}, sorted{true}
+{
+}
+
+
+void DeletionIndex::add(const std::string& word)
+{
+    if (distinct.count(word) != 0)
+        return;
+
+    unsigned int index = static_cast<unsigned int>(words.size());
+    words.push_back(word);
+    distinct.insert(words.back());
+
+    for (const std::string& deletion : deletionsOf(word, distance))
+        entries.push_back(Entry{StringHash{}(deletion), index});
+
+    sorted.store(false, std::memory_order_relaxed);
+}
+
+
+unsigned int DeletionIndex::size() const noexcept
+{
+    return static_cast<unsigned int>(words.size());
+}
+
+
+unsigned int DeletionIndex::maxDistance() const noexcept
+{
+    return distance;
+}
+
+
+unsigned int DeletionIndex::deletionCount() const noexcept
+{
+    return static_cast<unsigned int>(entries.size());
+}
+
+
+std::vector<std::string> DeletionIndex::suggestions(
+    const std::string& word, unsigned int maxDistance) const
+{
+    prepare();
+
+    maxDistance = std::min(maxDistance, distance);
+
+    // Gather the index of every word that shares a deletion with this one.
+    std::vector<unsigned int> candidates;
+    for (const std::string& deletion : deletionsOf(word, maxDistance))
+    {
+        unsigned int hash = StringHash{}(deletion);
+
+        auto first = std::lower_bound(
+            entries.begin(), entries.end(), hash,
+            [](const Entry& entry, unsigned int h) { return entry.hash < h; });
+
+        for (auto i = first; i != entries.end() && i->hash == hash; ++i)
+            candidates.push_back(i->word);
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // Keep only those that really are close enough.
+    std::vector<std::pair<unsigned int, std::string_view>> found;
+    for (unsigned int candidate : candidates)
+    {
+        const std::string& other = words[candidate];
+        if (other == word)
+            continue;
+
+        unsigned int d = editDistance(word, other, maxDistance);
+        if (d <= maxDistance)
+            found.emplace_back(d, other);
+    }
+
+    return nearestFirst(std::move(found));
+}
+
+
+void DeletionIndex::prepare() const
+{
+    if (sorted.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    if (sorted.load(std::memory_order_relaxed))
+        return;
+
+    std::sort(
+        entries.begin(), entries.end(),
+        [](const Entry& a, const Entry& b)
+        {
+            return a.hash < b.hash || (a.hash == b.hash && a.word < b.word);
+        });
+
+    sorted.store(true, std::memory_order_release);
+}
@@ -0,0 +1,111 @@
+// DeletionIndex.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A DeletionIndex is a SuggestionIndex that finds nearby words by way of
+// their deletions, the technique popularized by SymSpell.
+//
+// If two words are within an edit distance of d of each other, then it's
+// possible to delete at most d characters from each of them and end up
+// with the same string: an insertion into one is a deletion from the
+// other, a replacement is a deletion from both at the same position, and
+// a swap of two characters is a deletion of the first from one and of the
+// second from the other.  So, as each word is added, every string that
+// can be made by deleting up to maxDistance of its characters is recorded
+// as leading back to it.  Searching for a word then generates the same
+// deletions of it -- a few dozen strings, rather than the thousands of
+// misspellings that WordChecker's five strategies generate at distance
+// two -- and gathers every word that any of them leads back to.  Sharing a
+// deletion doesn't guarantee that two words are close (deleting "AB" and
+// "CD" from "ABCD" and "CDAB" both leave "CD", but the words are four
+// edits apart), so each word gathered this way is checked with
+// editDistance() before it's suggested.
+//
+// Rather than storing the deletions themselves, which would take many
+// times as much memory as the words do, only a hash of each one is kept,
+// alongside the index of the word it came from, in one flat array that's
+// sorted by hash, so that finding the words a deletion leads back to is a
+// binary search.  Two deletions with the same hash just mean a few extra
+// words are checked and rejected.
+//
+// Words are added one at a time, while the dictionary is being loaded.
+// Sorting the array is put off until the first search after words have
+// been added, so loading costs one append per deletion; that first search
+// sorts the array while holding a lock, so that searches from many threads
+// at once are safe (though adding words while searching is not).
+
+#ifndef DELETIONINDEX_HPP
+#define DELETIONINDEX_HPP
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "SuggestionIndex.hpp"
+
+
+
+class DeletionIndex : public SuggestionIndex
+{
+public:
+    // The constructor takes the largest edit distance that the index will
+    // be able to search.  The number of deletions recorded for each word
+    // grows quickly with it, so it should be as small as will be needed;
+    // two is what spell checkers usually use.
+    explicit DeletionIndex(unsigned int maxDistance = 2);
+
+    ~DeletionIndex() noexcept override = default;
+
+
+    // add() adds a word to the index, if it isn't already there.
+    void add(const std::string& word);
+
+
+    // size() returns the number of distinct words in the index.
+    unsigned int size() const noexcept;
+
+
+    // maxDistance() returns the largest edit distance the index can search,
+    // which is the one it was constructed with.
+    unsigned int maxDistance() const noexcept override;
+
+
+    // deletionCount() returns the number of deletions recorded for all of
+    // the words in the index, which is what its memory use is driven by.
+    unsigned int deletionCount() const noexcept;
+
+
+    std::vector<std::string> suggestions(
+        const std::string& word, unsigned int maxDistance) const override;
+
+
+private:
+    struct Entry
+    {
+        unsigned int hash;
+        unsigned int word;
+    };
+
+    void prepare() const;
+
+
+private:
+    unsigned int distance;
+
+    // The words are kept in a deque so that adding one never moves the
+    // others, which lets the set of them refer to them without copying.
+    std::deque<std::string> words;
+    std::unordered_set<std::string_view> distinct;
+
+    mutable std::vector<Entry> entries;
+    mutable std::atomic<bool> sorted;
+    mutable std::mutex mutex;
+};
+
+
+
+#endif
@@ -0,0 +1,133 @@
+// DocumentChecker.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "DocumentChecker.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+
+namespace
+{
+    bool isLetter(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+
+    char toUpper(char c)
+    {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+
+    // A Token is one appearance of a word in a document, along with the
+    // index of that word among the batch's distinct words.
+    struct Token
+    {
+        std::size_t offset;
+        std::size_t length;
+        unsigned int word;
+    };
+
+
+    // A CheckedWord is one of the distinct words in a batch, along with
+    // what the WordChecker had to say about it.
+    struct CheckedWord
+    {
+        std::string word;
+        bool exists = false;
+        std::vector<std::string> suggestions;
+    };
+
+
+    // Each task given to the pool checks a run of this many distinct words.
+    // Runs are short enough that there are plenty of them to balance
+    // between threads, but long enough that taking a task costs little
+    // compared to running it.
+    constexpr unsigned int WORDS_PER_TASK = 16;
+}
+
+
+DocumentChecker::DocumentChecker(const WordChecker& checker, unsigned int threadCount)
+    : checker{checker}, pool{threadCount}
+{
+}
+
+
+std::vector<DocumentChecker::WordResult> DocumentChecker::check(const std::string& document)
+{
+    return std::move(checkAll({document}).front());
+}
+
+
+std::vector<std::vector<DocumentChecker::WordResult>> DocumentChecker::checkAll(
+    const std::vector<std::string>& documents)
+{
+    std::vector<CheckedWord> words;
+    std::unordered_map<std::string, unsigned int> indexes;
+    std::vector<std::vector<Token>> tokens(documents.size());
+
+    //tokenize, giving each distinct word an index the first time it appears
+    std::string word;
+    for (std::size_t d = 0; d < documents.size(); d++)
+    {
+        const std::string& document = documents[d];
+
+        for (std::size_t i = 0; i < document.size(); )
+        {
+            if (!isLetter(document[i]))
+            {
+                i++;
+                continue;
+            }
+
+            std::size_t start = i;
+            word.clear();
+            for (; i < document.size() && isLetter(document[i]); i++)
+                word += toUpper(document[i]);
+
+            auto [found, added] = indexes.try_emplace(word, static_cast<unsigned int>(words.size()));
+            if (added)
+                words.push_back(CheckedWord{word, false, {}});
+
+            tokens[d].push_back(Token{start, i - start, found->second});
+        }
+    }
+
+    //check each distinct word once
+    unsigned int taskCount =
+        static_cast<unsigned int>((words.size() + WORDS_PER_TASK - 1) / WORDS_PER_TASK);
+
+    pool.run(
+        taskCount,
+        [&](unsigned int task)
+        {
+            std::size_t first = static_cast<std::size_t>(task) * WORDS_PER_TASK;
+            std::size_t last = std::min(first + WORDS_PER_TASK, words.size());
+
+            for (std::size_t w = first; w < last; w++)
+            {
+                words[w].exists = checker.wordExists(words[w].word);
+                if (!words[w].exists)
+                    words[w].suggestions = checker.findSuggestions(words[w].word);
+            }
+        });
+
+    //list the results in document order
+    std::vector<std::vector<WordResult>> results(documents.size());
+    for (std::size_t d = 0; d < documents.size(); d++)
+    {
+        results[d].reserve(tokens[d].size());
+
+        for (const Token& token : tokens[d])
+        {
+            const CheckedWord& checked = words[token.word];
+            results[d].push_back(WordResult{
+                token.offset, token.length, checked.word, checked.exists, checked.suggestions});
+        }
+    }
+
+    return results;
+}
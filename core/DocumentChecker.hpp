@@ -0,0 +1,78 @@
+// DocumentChecker.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// The DocumentChecker class checks the spelling of every word in whole
+// documents at once, using a WordChecker, spreading the work across the
+// threads of a WorkStealingPool.
+//
+// Checking a batch of documents happens in three steps:
+//
+//   * Each document is split into words, which are the longest runs of
+//     letters in it, converted to uppercase (as the words in dictionaries
+//     are).  Everything else in a document separates words.
+//
+//   * Each distinct word in the batch is checked -- and, if it's not
+//     spelled correctly, given suggestions -- exactly once, no matter how
+//     many times it appears, with the distinct words divided among the
+//     pool's threads.  The WordChecker, and the Set it looks words up in,
+//     are shared by all of the threads, which only ever call their const
+//     member functions.
+//
+//   * The result for each word in each document is then listed, in the
+//     order the words appear in that document.
+
+#ifndef DOCUMENTCHECKER_HPP
+#define DOCUMENTCHECKER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "WordChecker.hpp"
+#include "WorkStealingPool.hpp"
+
+
+
+class DocumentChecker
+{
+public:
+    // A WordResult describes one appearance of a word in a document: where
+    // it appears (as the offset and length, in characters, of the original
+    // text), the word itself (in uppercase), whether it's spelled correctly,
+    // and, if it isn't, the suggestions the WordChecker gave for it.
+    struct WordResult
+    {
+        std::size_t offset;
+        std::size_t length;
+        std::string word;
+        bool exists;
+        std::vector<std::string> suggestions;
+    };
+
+public:
+    // The constructor requires the WordChecker to use, which it stores a
+    // reference to, and the number of threads to check words with (with
+    // 0 meaning one per core).
+    explicit DocumentChecker(const WordChecker& checker, unsigned int threadCount = 0);
+
+
+    // check() returns the results for every word in the given document,
+    // in the order the words appear.
+    std::vector<WordResult> check(const std::string& document);
+
+
+    // checkAll() returns the results for every word in each of the given
+    // documents, checking all of them as one batch, so that a word that
+    // appears in many of the documents is only checked once.
+    std::vector<std::vector<WordResult>> checkAll(const std::vector<std::string>& documents);
+
+
+private:
+    const WordChecker& checker;
+    WorkStealingPool pool;
+};
+
+
+
+#endif
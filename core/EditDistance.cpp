@@ -0,0 +1,142 @@
+// EditDistance.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "EditDistance.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+unsigned int editDistance(std::string_view a, std::string_view b, unsigned int limit)
+{
+    if (a.size() < b.size())
+        std::swap(a, b);
+
+    // Every character of the longer word that the shorter one lacks needs
+    // an insertion, so words whose lengths differ by more than the limit
+    // can't be within it.
+    if (a.size() - b.size() > limit)
+        return limit + 1;
+
+    // The usual dynamic programming table, one row at a time: row i holds
+    // the distances between the first i characters of a and each prefix
+    // of b.  A swap looks two rows back, so three rows are kept.
+    std::size_t n = b.size();
+    std::vector<unsigned int> before(n + 1), previous(n + 1), current(n + 1);
+
+    for (std::size_t j = 0; j <= n; j++)
+        previous[j] = static_cast<unsigned int>(j);
+
+    unsigned int previousSmallest = 0;
+
+    for (std::size_t i = 1; i <= a.size(); i++)
+    {
+        current[0] = static_cast<unsigned int>(i);
+        unsigned int smallest = current[0];
+
+        for (std::size_t j = 1; j <= n; j++)
+        {
+            unsigned int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost});
+
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                current[j] = std::min(current[j], before[j - 2] + 1);
+
+            smallest = std::min(smallest, current[j]);
+        }
+
+        // No distance in a row is smaller than the smallest in the row
+        // above it, or than one more than the smallest two rows up (which
+        // is as far back as a swap reaches), so once two rows in a row are
+        // entirely over the limit, every row after them will be, too.
+        if (smallest > limit && previousSmallest > limit)
+            return limit + 1;
+
+        previousSmallest = smallest;
+        std::swap(before, previous);
+        std::swap(previous, current);
+    }
+
+    return std::min(previous[n], limit + 1);
+}
+
+
+unsigned int damerauLevenshteinDistance(std::string_view a, std::string_view b)
+{
+    // This is the Lowrance-Wagner algorithm.  The table has an extra row
+    // and column of "infinite" distances bordering it, so that a swap
+    // reaching back past the start of either word is never the cheapest.
+    std::size_t m = a.size(), n = b.size();
+    std::size_t width = n + 2;
+    unsigned int infinity = static_cast<unsigned int>(m + n);
+
+    // Tables for words of ordinary lengths fit on the stack, so only
+    // measuring long words allocates memory.
+    constexpr std::size_t SMALL_TABLE_SIZE = 20 * 20;
+    std::array<unsigned int, SMALL_TABLE_SIZE> smallTable;
+    std::vector<unsigned int> largeTable;
+
+    unsigned int* table = smallTable.data();
+    if ((m + 2) * width > SMALL_TABLE_SIZE)
+    {
+        largeTable.resize((m + 2) * width);
+        table = largeTable.data();
+    }
+
+    auto at = [&](std::size_t i, std::size_t j) -> unsigned int& { return table[i * width + j]; };
+
+    at(0, 0) = infinity;
+    for (std::size_t i = 0; i <= m; i++)
+    {
+        at(i + 1, 0) = infinity;
+        at(i + 1, 1) = static_cast<unsigned int>(i);
+    }
+    for (std::size_t j = 0; j <= n; j++)
+    {
+        at(0, j + 1) = infinity;
+        at(1, j + 1) = static_cast<unsigned int>(j);
+    }
+
+    // lastRow[c] is the last row (counting from 1) of a in which the
+    // character c appeared, or 0 if it hasn't yet.  It's only ever read
+    // for characters of b, so only those need to start at 0.
+    std::array<std::size_t, 256> lastRow;
+    for (char c : b)
+        lastRow[static_cast<unsigned char>(c)] = 0;
+
+    for (std::size_t i = 1; i <= m; i++)
+    {
+        // lastColumn is the last column of b, in this row, whose character
+        // matched a's.
+        std::size_t lastColumn = 0;
+
+        for (std::size_t j = 1; j <= n; j++)
+        {
+            std::size_t k = lastRow[static_cast<unsigned char>(b[j - 1])];
+            std::size_t l = lastColumn;
+
+            unsigned int cost = 1;
+            if (a[i - 1] == b[j - 1])
+            {
+                cost = 0;
+                lastColumn = j;
+            }
+
+            // Swapping a[k] with a[i] costs one edit, plus whatever it
+            // takes to delete the characters of a between them and insert
+            // the characters of b between b[l] and b[j].
+            at(i + 1, j + 1) = std::min({
+                at(i, j) + cost,
+                at(i + 1, j) + 1,
+                at(i, j + 1) + 1,
+                at(k, l) + static_cast<unsigned int>((i - k - 1) + 1 + (j - l - 1))});
+        }
+
+        lastRow[static_cast<unsigned char>(a[i - 1])] = i;
+    }
+
+    return at(m + 1, n + 1);
+}
@@ -0,0 +1,70 @@
+// EditDistance.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// editDistance() measures how different two words are, as the fewest
+// edits that turn one into the other, where an edit is inserting one
+// character, deleting one character, replacing one character with
+// another, or swapping two adjacent characters -- the same edits that
+// WordChecker's suggestion strategies make.  (Splitting a word in two is
+// inserting a space.)  Once two characters have been swapped, neither of
+// them can be edited again; this is known as the "optimal string
+// alignment" distance, and it's what spell checkers usually mean by
+// edit distance.
+//
+// Usually, all that matters is whether two words are within some small
+// distance of each other, so editDistance() takes a limit: as soon as
+// it's clear that the distance is larger than the limit, it stops and
+// returns limit + 1.
+//
+// damerauLevenshteinDistance() lifts the restriction on swapped
+// characters, so that "CA" is two edits from "ABC" (swap, then insert
+// between them), rather than the three that editDistance() measures.
+// That makes it a true metric -- the distance from a to c is never more
+// than the distance from a to b plus the distance from b to c -- which
+// structures like BKTree rely on to rule words out without measuring
+// them.  It's never larger than editDistance(), so a search for words
+// within some damerauLevenshteinDistance() finds every word within that
+// editDistance(), too.
+//
+// nearestFirst() puts the words a search found, each paired with its
+// distance, in the order that suggestions are returned in: nearest first,
+// with words at the same distance in alphabetical order.
+
+#ifndef EDITDISTANCE_HPP
+#define EDITDISTANCE_HPP
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+
+unsigned int editDistance(
+    std::string_view a, std::string_view b,
+    unsigned int limit = std::numeric_limits<unsigned int>::max() - 1);
+
+
+unsigned int damerauLevenshteinDistance(std::string_view a, std::string_view b);
+
+
+template <typename StringType>
+std::vector<std::string> nearestFirst(std::vector<std::pair<unsigned int, StringType>> found)
+{
+    std::sort(found.begin(), found.end());
+
+    std::vector<std::string> words;
+    words.reserve(found.size());
+    for (auto& [distance, word] : found)
+        words.emplace_back(std::move(word));
+
+    return words;
+}
+
+
+
+#endif
@@ -0,0 +1,344 @@
+// FrozenAVLSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FrozenAVLSet is an immutable snapshot of an AVLSet, obtained by calling
+// the AVLSet's freeze() member function, which is meant for serving
+// lookups once a set has been fully built.  It contains the same elements
+// in the same order, but rather than in nodes scattered around the heap,
+// they're stored in one array laid out in "Eytzinger" order: the root of
+// a perfectly balanced binary search tree is at index 1, and the children
+// of the element at index k are at indexes 2k and 2k + 1.  That makes
+// the tree implicit -- there are no pointers to follow -- and places the
+// top levels of the tree, which every search passes through, next to
+// one another in memory.
+//
+// A search descends the implicit tree without branching on the outcome of
+// each comparison, using it arithmetically to pick the next index instead,
+// and prefetches the elements a couple of levels below its current one,
+// which are also next to one another, before it needs them.
+//
+// Since a FrozenAVLSet can't change once it's built, add() has no effect.
+
+#ifndef FROZENAVLSET_HPP
+#define FROZENAVLSET_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "BatchLookup.hpp"
+#include "LookupKey.hpp"
+#include "Set.hpp"
+
+
+
+template <typename ElementType>
+class FrozenAVLSet : public Set<ElementType>
+{
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+public:
+    // Initializes a FrozenAVLSet to be empty.
+    FrozenAVLSet() noexcept;
+
+    // Cleans up the FrozenAVLSet so that it leaks no memory.
+    ~FrozenAVLSet() noexcept override;
+
+    // Initializes a new FrozenAVLSet to be a copy of an existing one.
+    FrozenAVLSet(const FrozenAVLSet& s);
+
+    // Initializes a new FrozenAVLSet whose contents are moved from an
+    // expiring one.
+    FrozenAVLSet(FrozenAVLSet&& s) noexcept;
+
+    // Assigns an existing FrozenAVLSet into another.
+    FrozenAVLSet& operator=(const FrozenAVLSet& s);
+
+    // Assigns an expiring FrozenAVLSet into another.
+    FrozenAVLSet& operator=(FrozenAVLSet&& s) noexcept;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() has no effect, since a FrozenAVLSet can't be changed.
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  This function runs in O(log n) time.
+    bool contains(const ElementType& element) const override;
+
+
+    // These versions of contains() look for a lookup key (such as a
+    // std::string_view, or a pointer to characters and a length, in a set
+    // of std::strings), comparing it against the elements directly rather
+    // than building an ElementType from it first.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<ElementType, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // inorder() calls the given "visit" function for each of the elements
+    // in the set, in ascending order.
+    void inorder(VisitFunction visit) const;
+
+
+    // visitRange() calls the given "visit" function, in ascending order,
+    // for each of the elements in the set that are at least as large as
+    // low but smaller than high.
+    void visitRange(const ElementType& low, const ElementType& high, VisitFunction visit) const;
+
+
+private:
+    // AVLSet::freeze() builds a FrozenAVLSet by creating one of the right
+    // size and then appending its elements in ascending order.
+    template <typename, typename>
+    friend class AVLSet;
+
+    explicit FrozenAVLSet(unsigned int size);
+    void append(const ElementType& element);
+
+    template <typename KeyType>
+    unsigned int lowerBound(const KeyType& key) const;
+
+    void inorderhelper(VisitFunction& visit, unsigned int k) const;
+    void rangehelper(
+        const ElementType& low, const ElementType& high, VisitFunction& visit,
+        unsigned int k) const;
+
+private:
+    // The elements live at indexes 1 through iSize; index 0 is unused, so
+    // that the children of index k are always 2k and 2k + 1.
+    ElementType* elements = nullptr;
+    unsigned int iSize = 0;
+
+    // While the set is being built, next is the index at which the next
+    // (i.e., next largest) element will be stored.
+    unsigned int next = 0;
+};
+
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>::FrozenAVLSet() noexcept
+{
+}
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>::FrozenAVLSet(unsigned int size)
+    : elements{new ElementType[size + 1]}, iSize{size}
+{
+    //the smallest element is the leftmost one
+    next = 1;
+    while (2 * next <= iSize)
+        next *= 2;
+}
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::append(const ElementType& element)
+{
+    elements[next] = element;
+
+    //move to the next index in an inorder traversal: the leftmost index in
+    //the right subtree if there is one, or else the nearest ancestor that
+    //we're in the left subtree of
+    if (2 * next + 1 <= iSize)
+    {
+        next = 2 * next + 1;
+        while (2 * next <= iSize)
+            next *= 2;
+    }
+    else
+    {
+        while (next % 2 == 1)
+            next /= 2;
+        next /= 2;
+    }
+}
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>::~FrozenAVLSet() noexcept
+{
+    delete[] elements;
+}
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>::FrozenAVLSet(const FrozenAVLSet& s)
+    : iSize{s.iSize}
+{
+    if (s.elements)
+    {
+        elements = new ElementType[iSize + 1];
+        for (unsigned int k = 1; k <= iSize; k++)
+            elements[k] = s.elements[k];
+    }
+}
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>::FrozenAVLSet(FrozenAVLSet&& s) noexcept
+    : elements{s.elements}, iSize{s.iSize}
+{
+    s.elements = nullptr;
+    s.iSize = 0;
+}
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>& FrozenAVLSet<ElementType>::operator=(const FrozenAVLSet& s)
+{
+    if (this != &s)
+    {
+        FrozenAVLSet copy{s};
+        std::swap(elements, copy.elements);
+        std::swap(iSize, copy.iSize);
+    }
+    return *this;
+}
+
+
+template <typename ElementType>
+FrozenAVLSet<ElementType>& FrozenAVLSet<ElementType>::operator=(FrozenAVLSet&& s) noexcept
+{
+    std::swap(elements, s.elements);
+    std::swap(iSize, s.iSize);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool FrozenAVLSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::add(const ElementType& /* element */)
+{
+}
+
+
+template <typename ElementType>
+template <typename KeyType>
+unsigned int FrozenAVLSet<ElementType>::lowerBound(const KeyType& key) const
+{
+    // Descend all the way to the bottom of the tree, going right exactly
+    // when the element is smaller than the key; the last time we went left
+    // was at the smallest element that isn't.  The path taken is recorded
+    // in the bits of k, so undoing the right turns at the end of it (the
+    // trailing 1 bits) and then the final left turn leaves us there.  The
+    // result is 0 if every element is smaller than the key.
+    unsigned int k = 1;
+    while (k <= iSize)
+    {
+        if (4 * k <= iSize)
+            impl_::prefetch(&elements[4 * k]);
+        k = 2 * k + (impl_::compareKeys(elements[k], key) < 0 ? 1 : 0);
+    }
+
+    while (k % 2 == 1)
+        k /= 2;
+    return k / 2;
+}
+
+
+template <typename ElementType>
+bool FrozenAVLSet<ElementType>::contains(const ElementType& element) const
+{
+    unsigned int k = lowerBound(element);
+    return k != 0 && impl_::compareKeys(element, elements[k]) == 0;
+}
+
+
+template <typename ElementType>
+template <typename KeyType, typename>
+bool FrozenAVLSet<ElementType>::contains(const KeyType& key) const
+{
+    unsigned int k = lowerBound(key);
+    return k != 0 && impl_::compareKeys(key, elements[k]) == 0;
+}
+
+
+template <typename ElementType>
+bool FrozenAVLSet<ElementType>::contains(const char* chars, std::size_t length) const
+{
+    return contains(std::string_view{chars, length});
+}
+
+
+template <typename ElementType>
+unsigned int FrozenAVLSet<ElementType>::size() const noexcept
+{
+    return iSize;
+}
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::inorderhelper(VisitFunction& visit, unsigned int k) const
+{
+    if (k <= iSize)
+    {
+        inorderhelper(visit, 2 * k);
+        visit(elements[k]);
+        inorderhelper(visit, 2 * k + 1);
+    }
+}
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::inorder(VisitFunction visit) const
+{
+    inorderhelper(visit, 1);
+}
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::rangehelper(
+    const ElementType& low, const ElementType& high, VisitFunction& visit,
+    unsigned int k) const
+{
+    //only subtrees that can contain elements in the range are visited
+    if (k <= iSize)
+    {
+        bool aboveLow = !(elements[k] < low);
+        bool belowHigh = elements[k] < high;
+
+        if (aboveLow)
+            rangehelper(low, high, visit, 2 * k);
+        if (aboveLow && belowHigh)
+            visit(elements[k]);
+        if (belowHigh)
+            rangehelper(low, high, visit, 2 * k + 1);
+    }
+}
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::visitRange(
+    const ElementType& low, const ElementType& high, VisitFunction visit) const
+{
+    rangehelper(low, high, visit, 1);
+}
+
+
+
+#endif
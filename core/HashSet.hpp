@@ -14,6 +14,22 @@
 // elements as there are array cells), the HashSet should be resized so
 // that it is twice as large as it was before.
 //
+// A HashSet can alternatively be constructed with an open-addressing
+// layout, in which case the elements live directly in one contiguous
+// array of slots (using Robin Hood linear probing) instead of in
+// separately-allocated list nodes.  Both layouts grow according to the
+// same rule, so the capacity, and therefore the index that each element
+// hashes to, is the same either way.
+//
+// In either layout, every element is stored alongside its full hash value,
+// so lookups can skip most element comparisons and resizing never has to
+// call the hash function again.
+//
+// The separately-chained layout allocates its list nodes using the node
+// allocator given as the HashSet's third template argument (see
+// NodeAllocator.hpp); with an ArenaNodeAllocator, the nodes are carved out
+// of large blocks that are freed all at once when the set is destroyed.
+//
 // You are not permitted to use the containers in the C++ Standard Library
 // (such as std::set, std::map, or std::vector) to store the information
 // in your data structure.  Instead, you'll need to use a dynamically-
@@ -23,13 +39,39 @@
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "BatchLookup.hpp"
+#include "LookupKey.hpp"
+#include "NodeAllocator.hpp"
 #include "Set.hpp"
 
 
 
-template <typename ElementType>
-class HashSet : public Set<ElementType>
+// HashSetLayout selects how a HashSet stores its elements: in linked
+// lists hanging off of each array cell, or directly in the array cells
+// themselves.
+
+enum class HashSetLayout
+{
+    SeparateChaining,
+    OpenAddressing
+};
+
+
+
+template <
+    typename ElementType,
+    typename HashFunctionType = std::function<unsigned int(const ElementType&)>,
+    typename NodeAllocator = HeapNodeAllocator>
+class HashSet
+    : public Set<ElementType>,
+      public BatchLookup<typename PreferredLookupKey<ElementType>::Type>
 {
 public:
     // The default capacity of the HashSet before anything has been
@@ -37,13 +79,24 @@ public:
     static constexpr unsigned int DEFAULT_CAPACITY = 10;
 
     // A HashFunction is a function that takes a reference to a const
-    // ElementType and returns an unsigned int.
-    using HashFunction = std::function<unsigned int(const ElementType&)>;
+    // ElementType and returns an unsigned int.  By default, it's a
+    // std::function, so any kind of function can be used, at the cost of
+    // an indirect call on every hash; a HashSet can instead be given a
+    // function object type (such as StringHash) as its second template
+    // argument, so that the hashing can be inlined into each lookup.
+    using HashFunction = HashFunctionType;
+
+    // A BatchKey is the type of the keys accepted by containsMany().
+    using BatchKey = typename PreferredLookupKey<ElementType>::Type;
 
 public:
     // Initializes a HashSet to be empty, so that it will use the given
-    // hash function whenever it needs to hash an element.
-    explicit HashSet(HashFunction hashFunction);
+    // hash function whenever it needs to hash an element.  The layout
+    // determines whether elements are chained in linked lists (the
+    // default) or stored in an open-addressed array.
+    explicit HashSet(
+        HashFunction hashFunction,
+        HashSetLayout layout = HashSetLayout::SeparateChaining);
 
     // Cleans up the HashSet so that it leaks no memory.
     ~HashSet() noexcept override;
@@ -87,10 +140,55 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // These versions of contains() look for a lookup key (such as a
+    // std::string_view, or a pointer to characters and a length, in a set
+    // of std::strings) without building an ElementType from it, as long as
+    // the hash function accepts the key directly; StringHash does, and
+    // hashes a key to the same value as the equivalent element.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<ElementType, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
+    // containsMany() sets found[i] to whether keys[i] is in the set, for
+    // each i less than count.  It hashes a group of keys and prefetches the
+    // memory each one needs before comparing any of them, so the cache
+    // misses of all the keys in a group overlap instead of happening one
+    // after another.
+    void containsMany(const BatchKey* keys, unsigned int count, bool* found) const override;
+
+
+    // looksUpKeysDirectly() returns true if the hash function can be
+    // called with a BatchKey.  The default std::function can't, so each
+    // key would be turned into an ElementType before it's hashed.
+    bool looksUpKeysDirectly() const noexcept override;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
 
+    // memoryUsage() returns the number of bytes of memory the set's array
+    // and list nodes occupy, not counting the HashSet object itself, any
+    // memory that the elements allocate on their own, or the bookkeeping
+    // of the node allocator.
+    std::size_t memoryUsage() const noexcept;
+
+
+    // reserve() grows the array, if necessary, so that the set can hold
+    // at least n elements without being resized again.  The capacity is
+    // still chosen by repeatedly applying the capacity * 2 + 1 formula,
+    // but all of the existing elements are moved only once.
+    void reserve(unsigned int n);
+
+
+    // layout() returns the way in which this HashSet stores its elements.
+    HashSetLayout layout() const noexcept;
+
+
     // elementsAtIndex() returns the number of elements that hashed to a
     // particular index in the array.  If the index is out of the boundaries
     // of the array, this function returns 0.
@@ -105,17 +203,44 @@ public:
 
 private:
     HashFunction hashFunction;
+    HashSetLayout storage;
     int cap = 0;
+    // A Node is one element in a chained list, along with its full hash.
     struct Node
         {
             ElementType elem;
+            unsigned int hash = 0;
             Node * next = nullptr;
         };
+
+    // A Slot is one cell of the open-addressed array.  probe is one more
+    // than the distance of the slot from the index the element hashed to,
+    // so a probe of 0 marks an empty slot.
+    struct Slot
+        {
+            ElementType elem;
+            unsigned int hash = 0;
+            unsigned int probe = 0;
+        };
     int iSize = 0;
-    Node *hasharr;
+    Node *hasharr = nullptr;
+    Slot *slotarr = nullptr;
+    NodeAllocator allocator;
+
+    Node * newNode(const ElementType& element, unsigned int hash, Node * next);
+    void deleteNode(Node * node) noexcept;
+
+    void deleteAll() noexcept;
+    void copyAll(const HashSet& s);
+    template <typename KeyType>
+    unsigned int hashKey(const KeyType& key) const;
+
+    template <typename KeyType>
+    bool containshelper(const KeyType& key, unsigned int hashval) const;
 
-    // You'll no doubt want to add member variables and "helper" member
-    // functions here.
+    void rehash(int newcap);
+    void placeSlot(ElementType element, unsigned int hashval);
+    unsigned int nextSlot(unsigned int index) const noexcept;
 };
 
 
@@ -130,245 +255,401 @@ namespace impl_
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashFunction hashFunction)
-    : hashFunction{hashFunction}
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSet<ElementType, HashFunctionType, NodeAllocator>::HashSet(HashFunction hashFunction, HashSetLayout layout)
+    : hashFunction{hashFunction}, storage{layout}
 {
     cap = DEFAULT_CAPACITY;
-    hasharr = new Node[cap];
+    if (storage == HashSetLayout::OpenAddressing)
+        slotarr = new Slot[cap];
+    else
+        hasharr = new Node[cap];
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::~HashSet() noexcept
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+typename HashSet<ElementType, HashFunctionType, NodeAllocator>::Node *
+HashSet<ElementType, HashFunctionType, NodeAllocator>::newNode(
+    const ElementType& element, unsigned int hash, Node * next)
 {
-    for (int i = 0; i<cap; i++) 
+    void * memory = allocator.allocate(sizeof(Node));
+    try
+    {
+        return new (memory) Node{element, hash, next};
+    }
+    catch (...)
     {
-        for(int j = 0; hasharr[i].next != nullptr; j++ ) 
+        allocator.deallocate(memory, sizeof(Node));
+        throw;
+    }
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::deleteNode(Node * node) noexcept
+{
+    node->~Node();
+    allocator.deallocate(node, sizeof(Node));
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::deleteAll() noexcept
+{
+    // When the allocator is about to free every node's memory anyway, and
+    // there are no destructors to run, there's no need to visit the nodes.
+    constexpr bool visitNodes =
+        !NodeAllocator::RELEASES_ALL_AT_ONCE || !std::is_trivially_destructible_v<Node>;
+
+    if (hasharr && visitNodes)
+    {
+        for (int i = 0; i < cap; i++)
         {
-            Node * pt = hasharr[i].next->next;
-            delete hasharr[i].next;
-            hasharr[i].next = pt;
+            while (hasharr[i].next != nullptr)
+            {
+                Node * pt = hasharr[i].next->next;
+                deleteNode(hasharr[i].next);
+                hasharr[i].next = pt;
+            }
         }
     }
-    if (cap) 
-        delete[] hasharr;
-    else
-        delete hasharr;
+    delete[] hasharr;
+    delete[] slotarr;
+    allocator.reset();
+    hasharr = nullptr;
+    slotarr = nullptr;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(const HashSet& s)
-    : hashFunction{s.hashFunction}
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::copyAll(const HashSet& s)
 {
+    // The copy has the same capacity as the original, so every element
+    // belongs at the same index it occupies there; nothing is rehashed.
     cap = s.cap;
-    iSize = 0;
-    hasharr = new Node[cap];
-    for (int i = 0; i < cap; i++) 
+    iSize = s.iSize;
+    storage = s.storage;
+    if (s.slotarr)
+    {
+        slotarr = new Slot[cap];
+        for (int i = 0; i < cap; i++)
+            slotarr[i] = s.slotarr[i];
+    }
+    else if (s.hasharr)
     {
-        Node * tmp;
-        tmp = s.hasharr[i].next;
-        for (int j = 0; tmp != nullptr; tmp = s.hasharr[i].next->next) 
+        hasharr = new Node[cap];
+        for (int i = 0; i < cap; i++)
         {
-            iSize += 1;
-            int hashval = hashFunction(s.hasharr[i].next->elem) % cap;
-            Node* newNode = new Node{s.hasharr[i].next->elem,nullptr};
-            Node * tmp;
-            if (hasharr[hashval].next) 
-            {
-                tmp = hasharr[hashval].next;
-                for( int i = 0; tmp->next!=nullptr;tmp = tmp->next) { i++;}
-                tmp->next = newNode;
-            }
-            else 
+            Node * last = &hasharr[i];
+            for (Node * tmp = s.hasharr[i].next; tmp != nullptr; tmp = tmp->next)
             {
-                hasharr[hashval].next = newNode;
+                last->next = newNode(tmp->elem, tmp->hash, nullptr);
+                last = last->next;
             }
-            j++;
         }
-        
     }
-    
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashSet&& s) noexcept
-    : hashFunction{s.hashFunction}
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSet<ElementType, HashFunctionType, NodeAllocator>::~HashSet() noexcept
+{
+    deleteAll();
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSet<ElementType, HashFunctionType, NodeAllocator>::HashSet(const HashSet& s)
+    : hashFunction{s.hashFunction}, storage{s.storage}
+{
+    copyAll(s);
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSet<ElementType, HashFunctionType, NodeAllocator>::HashSet(HashSet&& s) noexcept
+    : hashFunction{s.hashFunction}, storage{s.storage}, allocator{std::move(s.allocator)}
 {
     cap = s.cap;
     iSize = s.iSize;
     hasharr = s.hasharr;
+    slotarr = s.slotarr;
     s.hasharr = nullptr;
+    s.slotarr = nullptr;
     s.cap = 0;
     s.iSize = 0;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSet<ElementType, HashFunctionType, NodeAllocator>& HashSet<ElementType, HashFunctionType, NodeAllocator>::operator=(const HashSet& s)
 {
-    
-    //delete this
-    for (int i = 0; i<cap; i++) 
-    {
-        for(int j = 0; hasharr[i].next != nullptr; j++ ) 
-        {
-            Node * pt = hasharr[i].next->next;
-            delete hasharr[i].next;
-            hasharr[i].next = pt;
-        }
-    }
-    if (cap) 
-        delete[] hasharr;
-    else
-        delete hasharr;
-
-    //copy construct this
-    cap = s.cap;
-    iSize = 0;
-    hasharr = new Node[cap];
-    for (int i = 0; i < cap; i++) 
+    if (this != &s)
     {
-        Node * tmp;
-        tmp = s.hasharr[i].next;
-        for (int j = 0; tmp != nullptr; tmp = s.hasharr[i].next->next) 
-        {
-            iSize += 1;
-            int hashval = hashFunction(s.hasharr[i].next->elem) % cap;
-            Node* newNode = new Node{s.hasharr[i].next->elem,nullptr};
-            Node * tmp;
-            if (hasharr[hashval].next) 
-            {
-                tmp = hasharr[hashval].next;
-                for( int i = 0; tmp->next!=nullptr;tmp = tmp->next) { i++;}
-                tmp->next = newNode;
-            }
-            else 
-            {
-                hasharr[hashval].next = newNode;
-            }
-            j++;
-        }
-        
+        deleteAll();
+        hashFunction = s.hashFunction;
+        copyAll(s);
     }
     return * this;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSet<ElementType, HashFunctionType, NodeAllocator>& HashSet<ElementType, HashFunctionType, NodeAllocator>::operator=(HashSet&& s) noexcept
 {
-    //delete this
     if (this != &s)
     {
-        for (int i = 0; i<cap; i++) 
-        {
-            for(int j = 0; hasharr[i].next != nullptr; j++ ) 
-            {
-                Node * pt = hasharr[i].next->next;
-                delete hasharr[i].next;
-                hasharr[i].next = pt;
-            }
-        }
-        if (cap) 
-            delete[] hasharr;
-        else
-            delete hasharr;
+        //delete this
+        deleteAll();
 
         //move this;
         cap = s.cap;
         iSize = s.iSize;
+        storage = s.storage;
         hasharr = s.hasharr;
+        slotarr = s.slotarr;
         hashFunction = s.hashFunction;
+        allocator = std::move(s.allocator);
         s.hasharr = nullptr;
+        s.slotarr = nullptr;
         s.cap = 0;
         s.iSize = 0;
-
-
     }
     return *this;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::isImplemented() const noexcept
 {
     return true;
 }
 
 
-template <typename ElementType>
-void HashSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+unsigned int HashSet<ElementType, HashFunctionType, NodeAllocator>::nextSlot(unsigned int index) const noexcept
 {
-    if (this->contains(element))
-        return;
-    else
+    index++;
+    return index == static_cast<unsigned int>(cap) ? 0 : index;
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::placeSlot(ElementType element, unsigned int hashval)
+{
+    // Robin Hood insertion: walk forward from the home index, and whenever
+    // the resident element is closer to its own home than we are to ours,
+    // take its slot and carry it forward instead.  This keeps every probe
+    // sequence short and lets unsuccessful lookups stop early.
+    unsigned int index = hashval % cap;
+    unsigned int probe = 1;
+    while (true)
     {
-        iSize += 1;
-        int hashval = hashFunction(element) % cap;
-        Node* newNode = new Node{element,nullptr};
-        Node * tmp;
-        if (hasharr[hashval].next) 
+        Slot& slot = slotarr[index];
+        if (slot.probe == 0)
         {
-            tmp = hasharr[hashval].next;
-            for( int i = 0; tmp->next!=nullptr;tmp = tmp->next) { i++;}
-            tmp->next = newNode;
+            slot.elem = std::move(element);
+            slot.hash = hashval;
+            slot.probe = probe;
+            return;
         }
-        else 
+        else if (slot.probe < probe)
         {
-            hasharr[hashval].next = newNode;
+            std::swap(slot.elem, element);
+            std::swap(slot.hash, hashval);
+            std::swap(slot.probe, probe);
         }
+        probe++;
+        index = nextSlot(index);
     }
-    if ((cap*0.8) < iSize) 
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::rehash(int newcap)
+{
+    // Existing elements are never copied here: chained nodes are relinked
+    // onto the front of their new list, and open-addressed elements are
+    // moved into their new slots.
+    // The layout is decided by storage rather than by which array exists,
+    // since a moved-from set has neither.
+    int oldcap = cap;
+    cap = newcap;
+    if (storage == HashSetLayout::OpenAddressing)
+    {
+        Slot * tmp = slotarr;
+        slotarr = new Slot[cap];
+        for (int i = 0; i < oldcap; i++)
+        {
+            if (tmp[i].probe != 0)
+                placeSlot(std::move(tmp[i].elem), tmp[i].hash);
+        }
+        delete[] tmp;
+    }
+    else
     {
-        int oldcap = cap;
-        cap = oldcap * 2 + 1;
         Node * tmp = hasharr;
         hasharr = new Node[cap];
-        iSize = 0;
-        for (int i =0; i < oldcap;i++) 
+        for (int i = 0; i < oldcap; i++)
         {
-            Node * pt;
-            while(tmp[i].next != nullptr)
+            while (tmp[i].next != nullptr)
             {
+                Node * pt = tmp[i].next;
+                tmp[i].next = pt->next;
 
-                iSize++;
-                int hashval = hashFunction(tmp[i].next->elem) % cap;
-                Node* newNode = new Node{tmp[i].next->elem,nullptr};
-               
-                if (hasharr[hashval].next) 
-                {
-                    Node * tmp;
-                    tmp = hasharr[hashval].next;
-                    for( int i = 0; tmp->next!=nullptr;tmp = tmp->next) {i++;}
-                    tmp->next = newNode;
-                }
-                else 
-                {
-                    hasharr[hashval].next = newNode;
-                } 
-
-                pt = tmp[i].next->next;
-                delete tmp[i].next;
-                tmp[i].next = pt;
+                int index = pt->hash % cap;
+                pt->next = hasharr[index].next;
+                hasharr[index].next = pt;
             }
-            delete tmp[i].next;
-
         }
         delete[] tmp;
     }
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::reserve(unsigned int n)
+{
+    int newcap = cap;
+    while ((newcap*0.8) < n)
+        newcap = newcap * 2 + 1;
+
+    if (newcap != cap)
+        rehash(newcap);
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::add(const ElementType& element)
 {
-    int hashval = hashFunction(element) % cap;
-    Node* tmp = hasharr[hashval].next;
+    if (cap == 0)
+        rehash(DEFAULT_CAPACITY);
+
+    unsigned int hashval = hashFunction(element);
+    if (containshelper(element, hashval))
+        return;
+    else if (slotarr)
+        placeSlot(element, hashval);
+    else
+    {
+        int index = hashval % cap;
+        hasharr[index].next = newNode(element, hashval, hasharr[index].next);
+    }
+
+    iSize += 1;
+    if ((cap*0.8) < iSize)
+        rehash(cap * 2 + 1);
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::contains(const ElementType& element) const
+{
+    return containshelper(element, hashFunction(element));
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+template <typename KeyType, typename>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::contains(const KeyType& key) const
+{
+    return containshelper(key, hashKey(key));
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::contains(const char* chars, std::size_t length) const
+{
+    return contains(std::string_view{chars, length});
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+void HashSet<ElementType, HashFunctionType, NodeAllocator>::containsMany(
+    const BatchKey* keys, unsigned int count, bool* found) const
+{
+    constexpr unsigned int GROUP_SIZE = 16;
+    unsigned int hashes[GROUP_SIZE];
+
+    if (cap == 0)
+    {
+        std::fill_n(found, count, false);
+        return;
+    }
+
+    for (unsigned int start = 0; start < count; start += GROUP_SIZE)
+    {
+        unsigned int n = std::min(GROUP_SIZE, count - start);
+
+        for (unsigned int i = 0; i < n; i++)
+        {
+            hashes[i] = hashKey(keys[start + i]);
+            if (slotarr)
+                impl_::prefetch(&slotarr[hashes[i] % cap]);
+            else
+                impl_::prefetch(&hasharr[hashes[i] % cap]);
+        }
+
+        // In the chained layout, the first node of each list is another
+        // miss waiting to happen, so start on those as well.
+        if (hasharr)
+        {
+            for (unsigned int i = 0; i < n; i++)
+                impl_::prefetch(hasharr[hashes[i] % cap].next);
+        }
+
+        for (unsigned int i = 0; i < n; i++)
+            found[start + i] = containshelper(keys[start + i], hashes[i]);
+    }
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::looksUpKeysDirectly() const noexcept
+{
+    return std::is_invocable_v<const HashFunction&, const BatchKey&>;
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+template <typename KeyType>
+unsigned int HashSet<ElementType, HashFunctionType, NodeAllocator>::hashKey(const KeyType& key) const
+{
+    // A hash function that only accepts ElementType (such as the default
+    // std::function) leaves us no choice but to build one.
+    if constexpr (std::is_invocable_v<const HashFunction&, const KeyType&>)
+        return hashFunction(key);
+    else
+        return hashFunction(ElementType{key});
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+template <typename KeyType>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::containshelper(const KeyType& element, unsigned int hashval) const
+{
+    if (cap == 0)
+        return false;
+    else if (slotarr)
+    {
+        unsigned int index = hashval % cap;
+        for (unsigned int probe = 1; ; probe++)
+        {
+            const Slot& slot = slotarr[index];
+
+            // Either an empty slot or one whose element is closer to home
+            // than we'd be; Robin Hood insertion would have put us here.
+            if (slot.probe < probe)
+                return false;
+            else if (slot.hash == hashval && slot.elem == element)
+                return true;
+            index = nextSlot(index);
+        }
+    }
+
+    Node* tmp = hasharr[hashval % cap].next;
     for (int i = 0; tmp != nullptr; i++) {
-        if (tmp->elem == element) 
+        if (tmp->hash == hashval && tmp->elem == element)
         {
             return true;
         }
@@ -378,19 +659,50 @@ bool HashSet<ElementType>::contains(const ElementType& element) const
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::size() const noexcept
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+unsigned int HashSet<ElementType, HashFunctionType, NodeAllocator>::size() const noexcept
 {
     return iSize;
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+std::size_t HashSet<ElementType, HashFunctionType, NodeAllocator>::memoryUsage() const noexcept
+{
+    // The chained layout's array holds the head of each list, which isn't
+    // an element; every element has a node of its own.
+    if (slotarr)
+        return static_cast<std::size_t>(cap) * sizeof(Slot);
+    else
+        return (static_cast<std::size_t>(cap) + iSize) * sizeof(Node);
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+HashSetLayout HashSet<ElementType, HashFunctionType, NodeAllocator>::layout() const noexcept
+{
+    return storage;
+}
+
+
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+unsigned int HashSet<ElementType, HashFunctionType, NodeAllocator>::elementsAtIndex(unsigned int index) const
 {
-    if (index > cap) 
+    if (index >= static_cast<unsigned int>(cap))
         return 0;
-    else 
+    else if (slotarr)
+    {
+        // Everything that hashed to this index sits in the unbroken run of
+        // occupied slots that starts there.
+        unsigned int cnt = 0;
+        for (unsigned int i = index; slotarr[i].probe != 0; i = nextSlot(i))
+        {
+            if (slotarr[i].hash % cap == index)
+                cnt++;
+        }
+        return cnt;
+    }
+    else
     {
         Node * tmp = hasharr[index].next;
         int cnt = 0;
@@ -403,17 +715,21 @@ unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned int index) const
+template <typename ElementType, typename HashFunctionType, typename NodeAllocator>
+bool HashSet<ElementType, HashFunctionType, NodeAllocator>::isElementAtIndex(const ElementType& element, unsigned int index) const
 {
-    if (index > cap) 
-        return 0;
-    else 
+    if (index >= static_cast<unsigned int>(cap))
+        return false;
+
+    unsigned int hashval = hashFunction(element);
+    if (slotarr)
+        return hashval % cap == index && containshelper(element, hashval);
+    else
     {
         Node * tmp = hasharr[index].next;
         for(int cnt = 0; tmp != nullptr; cnt++)
         {
-            if (tmp->elem == element)
+            if (tmp->hash == hashval && tmp->elem == element)
                 return true;
             tmp = tmp->next;
         }
@@ -424,4 +740,3 @@ bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned
 
 
 #endif
-
@@ -0,0 +1,97 @@
+// LevenshteinAutomaton.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "LevenshteinAutomaton.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+
+LevenshteinAutomaton::LevenshteinAutomaton(std::string_view word, unsigned int maxDistance)
+    : word{word}, limit{std::min(maxDistance, std::numeric_limits<unsigned int>::max() - 2)}
+{
+}
+
+
+LevenshteinAutomaton::State LevenshteinAutomaton::start() const
+{
+    // Nothing fed yet is j deletions away from the word's first j
+    // characters.  There's no row before it, so previousRow is left empty,
+    // which step() takes to mean that no swap is possible yet.
+    State state;
+    state.row.resize(word.size() + 1);
+    state.last = '\0';
+
+    for (std::size_t j = 0; j <= word.size(); j++)
+        state.row[j] = std::min(static_cast<unsigned int>(j), limit + 1);
+
+    return state;
+}
+
+
+LevenshteinAutomaton::State LevenshteinAutomaton::step(const State& state, char c) const
+{
+    State next;
+    step(state, c, next);
+    return next;
+}
+
+
+void LevenshteinAutomaton::step(const State& state, char c, State& next) const
+{
+    std::size_t n = word.size();
+    const std::vector<unsigned int>& row = state.row;
+    const std::vector<unsigned int>& before = state.previousRow;
+
+    next.row.resize(n + 1);
+    next.last = c;
+
+    next.row[0] = std::min(row[0] + 1, limit + 1);
+
+    for (std::size_t j = 1; j <= n; j++)
+    {
+        unsigned int cost = word[j - 1] == c ? 0 : 1;
+        unsigned int d = std::min({row[j - 1] + cost, row[j] + 1, next.row[j - 1] + 1});
+
+        // Feeding c after last matches the word's last two characters
+        // here swapped, which costs one edit past the row before.
+        if (!before.empty() && j >= 2 && word[j - 1] == state.last && word[j - 2] == c)
+            d = std::min(d, before[j - 2] + 1);
+
+        next.row[j] = std::min(d, limit + 1);
+    }
+
+    next.previousRow.assign(row.begin(), row.end());
+}
+
+
+bool LevenshteinAutomaton::isMatch(const State& state) const noexcept
+{
+    return state.row.back() <= limit;
+}
+
+
+bool LevenshteinAutomaton::canMatch(const State& state) const noexcept
+{
+    // A swap can reach back to the row before, at the cost of one edit.
+    unsigned int best = *std::min_element(state.row.begin(), state.row.end());
+
+    if (!state.previousRow.empty())
+        best = std::min(best, *std::min_element(state.previousRow.begin(), state.previousRow.end()) + 1);
+
+    return best <= limit;
+}
+
+
+unsigned int LevenshteinAutomaton::distance(const State& state) const noexcept
+{
+    return state.row.back();
+}
+
+
+unsigned int LevenshteinAutomaton::maxDistance() const noexcept
+{
+    return limit;
+}
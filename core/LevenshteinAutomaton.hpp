@@ -0,0 +1,90 @@
+// LevenshteinAutomaton.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A LevenshteinAutomaton recognizes the strings within some edit distance
+// (as measured by editDistance(), so swaps count as one edit) of a given
+// word.  Feeding it a string one character at a time says, after each
+// one, both whether the string so far is close enough to the word, and
+// whether it could still become close enough with more characters added.
+// The second is what makes it useful: walking a DAWGSet's transitions in
+// step with the automaton, and abandoning every transition after which
+// nothing could match, visits only the small part of the dictionary
+// that's near the word, and finds every word within the distance without
+// generating a single candidate misspelling.
+//
+// The automaton is never built as a table of states and transitions;
+// it's simulated instead.  Each State is one row of the table that
+// editDistance() fills in -- the distance from what's been fed so far to
+// each prefix of the word -- along with the row before it and the last
+// character fed, which are what a swap looks back at.  step() computes
+// the next row from them every time it's called, nothing is cached, and
+// feeding a character takes time proportional to the word's length.
+// Distances past maxDistance are all stored as maxDistance + 1, since the
+// only thing that matters about them is that they're too far.
+
+#ifndef LEVENSHTEINAUTOMATON_HPP
+#define LEVENSHTEINAUTOMATON_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class LevenshteinAutomaton
+{
+public:
+    struct State
+    {
+        std::vector<unsigned int> row;
+        std::vector<unsigned int> previousRow;
+        char last;
+    };
+
+
+public:
+    // The constructor takes the word to match and the largest edit
+    // distance from it that counts as a match.
+    LevenshteinAutomaton(std::string_view word, unsigned int maxDistance);
+
+
+    // start() returns the State before any characters have been fed.
+    State start() const;
+
+
+    // step() returns the State after feeding one more character.  The
+    // second form stores it in next instead, reusing the memory next
+    // already has, which saves a search from allocating at every step.
+    State step(const State& state, char c) const;
+    void step(const State& state, char c, State& next) const;
+
+
+    // isMatch() returns true if the string fed to reach the given State is
+    // within maxDistance of the word.
+    bool isMatch(const State& state) const noexcept;
+
+
+    // canMatch() returns true if the string fed to reach the given State,
+    // or any string that starts with it, could be within maxDistance of the
+    // word.  Once it returns false, stepping further is pointless.
+    bool canMatch(const State& state) const noexcept;
+
+
+    // distance() returns the edit distance from the string fed to reach the
+    // given State to the word, or maxDistance + 1 if it's further than that.
+    unsigned int distance(const State& state) const noexcept;
+
+
+    unsigned int maxDistance() const noexcept;
+
+
+private:
+    std::string word;
+    unsigned int limit;
+};
+
+
+
+#endif
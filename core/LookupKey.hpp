@@ -0,0 +1,54 @@
+// LookupKey.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A lookup key is a type, other than a set's own ElementType, that can be
+// searched for directly in that set -- most notably, a std::string_view
+// in a set of std::strings -- so that callers who have the characters of
+// a word somewhere other than in a std::string don't have to build one
+// just to ask whether the set contains it.  A lookup key has to compare
+// with ElementType using == and <, and hashes to the same value as the
+// equivalent element would (when hashed by a function that accepts both).
+
+#ifndef LOOKUPKEY_HPP
+#define LOOKUPKEY_HPP
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+
+template <typename ElementType, typename KeyType>
+inline constexpr bool isLookupKey = false;
+
+
+template <>
+inline constexpr bool isLookupKey<std::string, std::string_view> = true;
+
+
+
+namespace impl_
+{
+    // compareKeys() returns a negative number if key comes before element,
+    // a positive number if it comes after, or zero if they're equal.  For
+    // strings, that takes one pass over their characters, rather than the
+    // two that asking == and then < would take.
+    template <typename KeyType, typename ElementType>
+    int compareKeys(const KeyType& key, const ElementType& element)
+    {
+        if constexpr (
+            std::is_convertible_v<const KeyType&, std::string_view>
+            && std::is_convertible_v<const ElementType&, std::string_view>)
+        {
+            return std::string_view{key}.compare(std::string_view{element});
+        }
+        else
+            return key < element ? -1 : (element < key ? 1 : 0);
+    }
+}
+
+
+
+#endif
@@ -0,0 +1,200 @@
+// NodeAllocator.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A node allocator decides where the nodes of a linked data structure --
+// the nodes of an AVLSet or SkipListSet, or the list nodes of a chained
+// HashSet -- are stored in memory.  Each of those classes takes the type
+// of its node allocator as a template argument, so the choice costs
+// nothing at run time.  There are two node allocators:
+//
+//   * HeapNodeAllocator, the default, allocates every node separately
+//     from the heap and frees it as soon as it's no longer needed.
+//
+//   * ArenaNodeAllocator carves nodes out of large blocks of memory,
+//     one after another, and frees the blocks only when the whole data
+//     structure is destroyed (or emptied).  This avoids a trip through
+//     the general-purpose allocator for every node, avoids its per-node
+//     bookkeeping overhead, and places nodes that are allocated together
+//     next to each other in memory, which tends to help lookups too.  A
+//     structure whose elements are trivially destructible can also skip
+//     visiting its nodes when destroyed, since there's nothing to do but
+//     free the blocks.
+//
+// A node allocator provides these member functions:
+//
+//   * allocate(size) returns memory suitable for any object of the given
+//     size; deallocate(p, size) returns memory obtained from allocate().
+//   * reset() frees all of its memory at once, which is only legal once
+//     every object in it has been destroyed.
+//
+// along with a constant, RELEASES_ALL_AT_ONCE, which is true if reset()
+// frees memory that deallocate() doesn't.  Copying a node allocator
+// yields one with no memory of its own, since a copy of a data structure
+// allocates its own nodes; moving one transfers all of its memory.
+
+#ifndef NODEALLOCATOR_HPP
+#define NODEALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+
+
+class HeapNodeAllocator
+{
+public:
+    static constexpr bool RELEASES_ALL_AT_ONCE = false;
+
+    void* allocate(std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+
+    void deallocate(void* p, std::size_t /* size */) noexcept
+    {
+        ::operator delete(p);
+    }
+
+
+    void reset() noexcept
+    {
+    }
+};
+
+
+
+class ArenaNodeAllocator
+{
+public:
+    static constexpr bool RELEASES_ALL_AT_ONCE = true;
+
+    // The size of each block of memory that nodes are carved out of.  A
+    // node larger than a quarter of this is given a block of its own.
+    static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+public:
+    ArenaNodeAllocator() noexcept = default;
+
+    ~ArenaNodeAllocator() noexcept
+    {
+        reset();
+    }
+
+
+    ArenaNodeAllocator(const ArenaNodeAllocator& /* a */) noexcept
+        : ArenaNodeAllocator{}
+    {
+    }
+
+
+    ArenaNodeAllocator(ArenaNodeAllocator&& a) noexcept
+        : blocks{a.blocks}, next{a.next}, end{a.end}
+    {
+        a.blocks = nullptr;
+        a.next = nullptr;
+        a.end = nullptr;
+    }
+
+
+    ArenaNodeAllocator& operator=(const ArenaNodeAllocator& /* a */) noexcept
+    {
+        return *this;
+    }
+
+
+    ArenaNodeAllocator& operator=(ArenaNodeAllocator&& a) noexcept
+    {
+        std::swap(blocks, a.blocks);
+        std::swap(next, a.next);
+        std::swap(end, a.end);
+        return *this;
+    }
+
+
+    void* allocate(std::size_t size)
+    {
+        size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+        if (size > BLOCK_SIZE / 4)
+        {
+            // Big allocations go in a block of their own, which is linked in
+            // behind the current one so that the current one keeps filling.
+            Block* block = newBlock(size);
+            if (blocks)
+            {
+                block->next = blocks->next;
+                blocks->next = block;
+            }
+            else
+                blocks = block;
+            return block->bytes();
+        }
+        else if (next == nullptr || static_cast<std::size_t>(end - next) < size)
+        {
+            Block* block = newBlock(BLOCK_SIZE);
+            block->next = blocks;
+            blocks = block;
+            next = block->bytes();
+            end = next + BLOCK_SIZE;
+        }
+
+        void* p = next;
+        next += size;
+        return p;
+    }
+
+
+    void deallocate(void* /* p */, std::size_t /* size */) noexcept
+    {
+    }
+
+
+    void reset() noexcept
+    {
+        while (blocks)
+        {
+            Block* block = blocks->next;
+            ::operator delete(blocks);
+            blocks = block;
+        }
+
+        next = nullptr;
+        end = nullptr;
+    }
+
+
+private:
+    static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+    // Each Block begins with a pointer to the next one, followed (at a
+    // suitably aligned offset) by the memory that nodes are carved from.
+    struct alignas(std::max_align_t) Block
+    {
+        Block* next = nullptr;
+
+        char* bytes() noexcept
+        {
+            return reinterpret_cast<char*>(this + 1);
+        }
+    };
+
+
+    static Block* newBlock(std::size_t size)
+    {
+        return new (::operator new(sizeof(Block) + size)) Block{};
+    }
+
+
+private:
+    Block* blocks = nullptr;
+    char* next = nullptr;
+    char* end = nullptr;
+};
+
+
+
+#endif
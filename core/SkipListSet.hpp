@@ -12,10 +12,17 @@
 // nodes, with pointers connecting them.  You can, however, use other parts of
 // the C++ Standard Library -- including <random>, notably.
 //
-// Each node should contain only two pointers: one to the node that follows it
-// on the same level and another to the equivalent node on the level below it.
-// Additional pointers use more memory but don't enable any techniques not
-// enabled by the other two.
+// Rather than keeping a separate node for each level an element occupies,
+// each element is stored in exactly one node, allocated all at once, that
+// ends with an array of forward pointers -- one for each level the
+// element occupies, pointing to the node that follows it on that level.
+// Most elements occupy only one or two levels, so most nodes hold only
+// one or two pointers, and moving down a level while searching means
+// looking at the next entry of the same array rather than following a
+// pointer to another node.
+//
+// Where the nodes are allocated is decided by the SkipListSet's second
+// template argument, a node allocator (see NodeAllocator.hpp).
 //
 // A couple of utilities are included here: SkipListKind and SkipListKey.
 // You can feel free to use these as-is and probably will not need to
@@ -24,9 +31,19 @@
 #ifndef SKIPLISTSET_HPP
 #define SKIPLISTSET_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <memory>
-#include <optional>
+#include <new>
 #include <random>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "LookupKey.hpp"
+#include "NodeAllocator.hpp"
 #include "Set.hpp"
 
 
@@ -52,6 +69,9 @@ enum class SkipListKind
 // to compare these keys using < or == operators (which are overloaded here)
 // and those comparisons respect the notion of whether each key is normal,
 // -INF, or +INF.
+//
+// A normal key refers to its element rather than holding a copy of it, so
+// building one costs nothing, but it mustn't outlive that element.
 
 template <typename ElementType>
 class SkipListKey
@@ -67,38 +87,44 @@ public:
     bool operator<(const SkipListKey& other) const;
     bool operator<(const ElementType& other) const;
 
+    // compare() returns a negative number if this key comes before the
+    // given element (or lookup key), a positive number if it comes after
+    // it, or zero if they're equal.
+    template <typename KeyType>
+    int compare(const KeyType& other) const;
+
 private:
-    SkipListKey(SkipListKind kind, std::optional<ElementType> element);
+    SkipListKey(SkipListKind kind, const ElementType* element);
 
 private:
     SkipListKind kind;
-    std::optional<ElementType> element;
+    const ElementType* element;
 };
 
 
 template <typename ElementType>
 SkipListKey<ElementType> SkipListKey<ElementType>::normal(const ElementType& element)
 {
-    return SkipListKey{SkipListKind::Normal, std::make_optional(element)};
+    return SkipListKey{SkipListKind::Normal, &element};
 }
 
 
 template <typename ElementType>
 SkipListKey<ElementType> SkipListKey<ElementType>::negInf()
 {
-    return SkipListKey{SkipListKind::NegInf, std::nullopt};
+    return SkipListKey{SkipListKind::NegInf, nullptr};
 }
 
 
 template <typename ElementType>
 SkipListKey<ElementType> SkipListKey<ElementType>::posInf()
 {
-    return SkipListKey{SkipListKind::PosInf, std::nullopt};
+    return SkipListKey{SkipListKind::PosInf, nullptr};
 }
 
 
 template <typename ElementType>
-SkipListKey<ElementType>::SkipListKey(SkipListKind kind, std::optional<ElementType> element)
+SkipListKey<ElementType>::SkipListKey(SkipListKind kind, const ElementType* element)
     : kind{kind}, element{element}
 {
 }
@@ -145,6 +171,109 @@ bool SkipListKey<ElementType>::operator<(const ElementType& other) const
 }
 
 
+template <typename ElementType>
+template <typename KeyType>
+int SkipListKey<ElementType>::compare(const KeyType& other) const
+{
+    switch (kind)
+    {
+    case SkipListKind::NegInf:
+        return -1;
+
+    case SkipListKind::PosInf:
+        return 1;
+
+    default: // SkipListKind::Normal
+        return -impl_::compareKeys(other, *element);
+    }
+}
+
+
+
+namespace impl_
+{
+    // A SkipListNode is the single node that holds one element of a skip
+    // list, followed directly in memory by its array of "levels" forward
+    // pointers (of type Link, which is either a plain or an atomic pointer
+    // to another SkipListNode).  The element is stored in the node itself,
+    // but is only constructed in normal nodes; the -INF and +INF nodes say
+    // so in their kind and contain no element at all.
+    template <typename ElementType, bool isAtomic>
+    struct alignas(void*) SkipListNode
+    {
+        using Link = std::conditional_t<isAtomic, std::atomic<SkipListNode*>, SkipListNode*>;
+
+        SkipListKind kind;
+        unsigned int levels;
+        alignas(ElementType) unsigned char storage[sizeof(ElementType)];
+
+
+        static std::size_t bytesFor(unsigned int levels) noexcept
+        {
+            return sizeof(SkipListNode) + levels * sizeof(Link);
+        }
+
+
+        // create() builds a node (with null forward pointers) in the given
+        // memory, which must be bytesFor(levels) bytes long.  If element
+        // is nullptr, the node is a sentinel of the given kind.
+        static SkipListNode* create(
+            void* memory, SkipListKind kind, unsigned int levels, const ElementType* element)
+        {
+            SkipListNode* node = new (memory) SkipListNode;
+            node->kind = kind;
+            node->levels = levels;
+
+            if (element)
+                new (node->storage) ElementType(*element);
+
+            for (unsigned int level = 0; level < levels; level++)
+                new (&node->next()[level]) Link{nullptr};
+
+            return node;
+        }
+
+
+        // destroy() destroys the node's element, if it has one, leaving its
+        // memory to be freed.
+        void destroy() noexcept
+        {
+            if (kind == SkipListKind::Normal)
+                element().~ElementType();
+        }
+
+
+        const ElementType& element() const noexcept
+        {
+            return *std::launder(reinterpret_cast<const ElementType*>(storage));
+        }
+
+
+        SkipListKey<ElementType> key() const noexcept
+        {
+            switch (kind)
+            {
+            case SkipListKind::NegInf:
+                return SkipListKey<ElementType>::negInf();
+
+            case SkipListKind::PosInf:
+                return SkipListKey<ElementType>::posInf();
+
+            default: // SkipListKind::Normal
+                return SkipListKey<ElementType>::normal(element());
+            }
+        }
+
+
+        Link* next() noexcept
+        {
+            static_assert(alignof(Link) <= alignof(SkipListNode));
+            return reinterpret_cast<Link*>(this + 1);
+        }
+    };
+}
+
+
 
 // The SkipListLevelTester class represents the ability to decide whether
 // a key placed on one level of the skip list should also occupy the next
@@ -161,6 +290,11 @@ bool SkipListKey<ElementType>::operator<(const ElementType& other) const
 // whole new level tester classes, but the ones declared below are part
 // of how we test your implementation, so they need to maintain the
 // parts of the interface that are declared already.
+//
+// A skip list asks its level tester how many levels a new element should
+// occupy by calling levelsFor(), which by default flips the coin once per
+// level until it comes up "no."  A level tester that can decide all at
+// once, like HashSkipListLevelTester below, can override it to do that.
 
 template <typename ElementType>
 class SkipListLevelTester
@@ -170,9 +304,23 @@ public:
 
     virtual bool shouldOccupyNextLevel(const ElementType& element) = 0;
     virtual std::unique_ptr<SkipListLevelTester<ElementType>> clone() = 0;
+
+    // levelsFor() returns the number of levels, from 1 to maxLevels, that
+    // the given element should occupy.
+    virtual unsigned int levelsFor(const ElementType& element, unsigned int maxLevels);
 };
 
 
+template <typename ElementType>
+unsigned int SkipListLevelTester<ElementType>::levelsFor(const ElementType& element, unsigned int maxLevels)
+{
+    unsigned int levels = 1;
+    while (levels < maxLevels && shouldOccupyNextLevel(element))
+        levels++;
+    return levels;
+}
+
+
 template <typename ElementType>
 class RandomSkipListLevelTester : public SkipListLevelTester<ElementType>
 {
@@ -188,15 +336,20 @@ private:
 };
 
 
+// The seed mixes in the constructing thread's ID, so that the clones a
+// ConcurrentSkipListSet makes for each of its threads flip different
+// coins even where std::random_device isn't actually random.
 template <typename ElementType>
 RandomSkipListLevelTester<ElementType>::RandomSkipListLevelTester()
-    : engine{std::random_device{}()}, distribution{0.5}
+    : engine{static_cast<std::default_random_engine::result_type>(
+          std::random_device{}() ^ std::hash<std::thread::id>{}(std::this_thread::get_id()))},
+      distribution{0.5}
 {
 }
 
 
 template <typename ElementType>
-bool RandomSkipListLevelTester<ElementType>::shouldOccupyNextLevel(const ElementType& element)
+bool RandomSkipListLevelTester<ElementType>::shouldOccupyNextLevel(const ElementType& /* element */)
 {
     return distribution(engine);
 }
@@ -211,10 +364,112 @@ std::unique_ptr<SkipListLevelTester<ElementType>> RandomSkipListLevelTester<Elem
 
 
 
+// A HashSkipListLevelTester decides how many levels an element occupies
+// from a hash of the element, rather than at random: the element occupies
+// one level more than the number of trailing zero bits in its hash (after
+// those bits are mixed, so that even a weak hash function leaves each bit
+// equally likely to be 0 or 1).  That gives the same distribution of
+// levels as flipping a fair coin, but costs one hash per element instead
+// of one random number per level, and it's deterministic: a skip list
+// built from the same elements always has the same structure, in every
+// run and every process, whatever order they're added in.
+//
+// The whole decision is made by levelsFor(), which counts the trailing
+// zero bits in one go.  Since shouldOccupyNextLevel() isn't told which
+// level it's being asked about, and keeps nothing from one call to the
+// next, all it can answer is whether the element occupies more than one
+// level, which it answers the same way every time.
+//
+// Its hash function is given to its constructor, the same way a HashSet's
+// is, and can likewise be made part of its type to avoid calling it
+// through a std::function:
+//
+//     HashSkipListLevelTester<std::string, StringHash> tester{StringHash{}};
+
+template <typename ElementType, typename HashFunctionType = std::function<unsigned int(const ElementType&)>>
+class HashSkipListLevelTester : public SkipListLevelTester<ElementType>
+{
+public:
+    using HashFunction = HashFunctionType;
+
+public:
+    explicit HashSkipListLevelTester(HashFunction hashFunction);
+
+    bool shouldOccupyNextLevel(const ElementType& element) override;
+    std::unique_ptr<SkipListLevelTester<ElementType>> clone() override;
+    unsigned int levelsFor(const ElementType& element, unsigned int maxLevels) override;
+
+private:
+    unsigned int mixedHash(const ElementType& element);
+
+private:
+    HashFunction hashFunction;
+};
+
+
+template <typename ElementType, typename HashFunctionType>
+HashSkipListLevelTester<ElementType, HashFunctionType>::HashSkipListLevelTester(HashFunction hashFunction)
+    : hashFunction{std::move(hashFunction)}
+{
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int HashSkipListLevelTester<ElementType, HashFunctionType>::mixedHash(const ElementType& element)
+{
+    //the finishing step of MurmurHash3, which makes every bit of the result
+    //depend on every bit of the hash
+    unsigned int h = hashFunction(element);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+bool HashSkipListLevelTester<ElementType, HashFunctionType>::shouldOccupyNextLevel(const ElementType& element)
+{
+    return levelsFor(element, 2) > 1;
+}
+
 
-template <typename ElementType>
+template <typename ElementType, typename HashFunctionType>
+std::unique_ptr<SkipListLevelTester<ElementType>> HashSkipListLevelTester<ElementType, HashFunctionType>::clone()
+{
+    return std::unique_ptr<SkipListLevelTester<ElementType>>{
+        new HashSkipListLevelTester<ElementType, HashFunctionType>{hashFunction}};
+}
+
+
+template <typename ElementType, typename HashFunctionType>
+unsigned int HashSkipListLevelTester<ElementType, HashFunctionType>::levelsFor(
+    const ElementType& element, unsigned int maxLevels)
+{
+    unsigned int h = mixedHash(element);
+
+    unsigned int levels = 1;
+    while (levels < maxLevels && levels <= 32 && (h & 1) == 0)
+    {
+        h >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+
+
+
+template <typename ElementType, typename NodeAllocator = HeapNodeAllocator>
 class SkipListSet : public Set<ElementType>
 {
+public:
+    // MAX_LEVELS is the most levels that a skip list can have.  Once an
+    // element is placed on the top level, no more coin flips are needed.
+    static constexpr unsigned int MAX_LEVELS = 32;
+
 public:
     // Initializes an SkipListSet to be empty, with or without a
     // "level tester" object that will decide, whenever a "coin flip"
@@ -258,6 +513,18 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // These versions of contains() look for a lookup key (such as a
+    // std::string_view, or a pointer to characters and a length, in a set
+    // of std::strings), comparing it against the elements directly rather
+    // than building an ElementType from it first.
+    template <
+        typename KeyType,
+        typename = std::enable_if_t<isLookupKey<ElementType, KeyType>>>
+    bool contains(const KeyType& key) const;
+
+    bool contains(const char* chars, std::size_t length) const;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -281,109 +548,359 @@ public:
     bool isElementOnLevel(const ElementType& element, unsigned int level) const;
 
 
+private:
+    using Node = impl_::SkipListNode<ElementType, false>;
+
+    Node* newNode(SkipListKind kind, unsigned int levels, const ElementType* element = nullptr);
+    void deleteNode(Node* node) noexcept;
+    void createSentinels();
+    void deleteAll() noexcept;
+    void copyAll(const SkipListSet& s);
+    unsigned int chooseLevels(const ElementType& element);
+
+    // A SkipListSet that's been moved from has no sentinels and no level
+    // tester, and behaves as an empty set until something is added to it,
+    // which is when they're recreated.
+    void restoreIfMovedFrom();
+    static std::unique_ptr<SkipListLevelTester<ElementType>> cloneLevelTester(const SkipListSet& s);
+
+    // findhelper() returns the node containing the given key, or nullptr
+    // if there isn't one.
+    template <typename KeyType>
+    Node* findhelper(const KeyType& key) const;
+
 private:
     std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
 
-    // You'll no doubt want to add member variables and "helper" member
-    // functions here.
+    // head is the -INF node, which occupies every level; tail is the +INF
+    // node, which ends every level and so needs no forward pointers.
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    unsigned int iSize = 0;
+    unsigned int levels = 1;
+    NodeAllocator allocator;
 };
 
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet()
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet()
     : SkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()}
 {
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
     : levelTester{std::move(levelTester)}
 {
+    createSentinels();
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::~SkipListSet() noexcept
+template <typename ElementType, typename NodeAllocator>
+typename SkipListSet<ElementType, NodeAllocator>::Node* SkipListSet<ElementType, NodeAllocator>::newNode(
+    SkipListKind kind, unsigned int levels, const ElementType* element)
 {
+    void* memory = allocator.allocate(Node::bytesFor(levels));
+    try
+    {
+        return Node::create(memory, kind, levels, element);
+    }
+    catch (...)
+    {
+        allocator.deallocate(memory, Node::bytesFor(levels));
+        throw;
+    }
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(const SkipListSet& s)
+template <typename ElementType, typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::deleteNode(Node* node) noexcept
 {
+    std::size_t bytes = Node::bytesFor(node->levels);
+    node->destroy();
+    allocator.deallocate(node, bytes);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(SkipListSet&& s) noexcept
+template <typename ElementType, typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::createSentinels()
 {
+    head = newNode(SkipListKind::NegInf, MAX_LEVELS);
+    tail = newNode(SkipListKind::PosInf, 0);
+    std::fill_n(head->next(), MAX_LEVELS, tail);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(const SkipListSet& s)
+template <typename ElementType, typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::deleteAll() noexcept
+{
+    //when the allocator is about to free every node's memory anyway, and
+    //there are no destructors to run, there's no need to visit the nodes
+    if constexpr (!NodeAllocator::RELEASES_ALL_AT_ONCE || !std::is_trivially_destructible_v<ElementType>)
+    {
+        //every node, including both sentinels, is on level 0
+        Node* node = head;
+        while (node)
+        {
+            Node* next = node != tail ? node->next()[0] : nullptr;
+            deleteNode(node);
+            node = next;
+        }
+    }
+
+    allocator.reset();
+    head = nullptr;
+    tail = nullptr;
+    iSize = 0;
+    levels = 1;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::~SkipListSet() noexcept
+{
+    deleteAll();
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::copyAll(const SkipListSet& s)
+{
+    createSentinels();
+
+    if (s.head == nullptr)
+        return;
+
+    //walking along the bottom level visits the nodes in order, so each
+    //copy can be attached behind the last copy made on each of its levels
+    Node* last[MAX_LEVELS];
+    std::fill_n(last, MAX_LEVELS, head);
+
+    for (Node* node = s.head->next()[0]; node != s.tail; node = node->next()[0])
+    {
+        Node* copy = newNode(SkipListKind::Normal, node->levels, &node->element());
+
+        for (unsigned int level = 0; level < node->levels; level++)
+        {
+            last[level]->next()[level] = copy;
+            last[level] = copy;
+        }
+    }
+
+    for (unsigned int level = 0; level < MAX_LEVELS; level++)
+        last[level]->next()[level] = tail;
+
+    iSize = s.iSize;
+    levels = s.levels;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet(const SkipListSet& s)
+    : levelTester{cloneLevelTester(s)}
+{
+    copyAll(s);
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet(SkipListSet&& s) noexcept
+    : levelTester{std::move(s.levelTester)}, head{s.head}, tail{s.tail},
+      iSize{s.iSize}, levels{s.levels}, allocator{std::move(s.allocator)}
+{
+    s.head = nullptr;
+    s.tail = nullptr;
+    s.iSize = 0;
+    s.levels = 1;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>& SkipListSet<ElementType, NodeAllocator>::operator=(const SkipListSet& s)
 {
+    if (this != &s)
+    {
+        deleteAll();
+        levelTester = cloneLevelTester(s);
+        copyAll(s);
+    }
     return *this;
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(SkipListSet&& s) noexcept
+template <typename ElementType, typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>& SkipListSet<ElementType, NodeAllocator>::operator=(SkipListSet&& s) noexcept
 {
+    //trade everything with s, whose destructor will clean up our old nodes
+    std::swap(levelTester, s.levelTester);
+    std::swap(head, s.head);
+    std::swap(tail, s.tail);
+    std::swap(iSize, s.iSize);
+    std::swap(levels, s.levels);
+    std::swap(allocator, s.allocator);
     return *this;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::isImplemented() const noexcept
 {
-    return false;
+    return true;
 }
 
 
-template <typename ElementType>
-void SkipListSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::chooseLevels(const ElementType& element)
 {
+    return levelTester->levelsFor(element, MAX_LEVELS);
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::restoreIfMovedFrom()
 {
-    return false;
+    if (!levelTester)
+        levelTester = std::make_unique<RandomSkipListLevelTester<ElementType>>();
+
+    if (head == nullptr)
+        createSentinels();
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::size() const noexcept
+template <typename ElementType, typename NodeAllocator>
+std::unique_ptr<SkipListLevelTester<ElementType>> SkipListSet<ElementType, NodeAllocator>::cloneLevelTester(
+    const SkipListSet& s)
 {
-    return 0;
+    if (s.levelTester)
+        return s.levelTester->clone();
+    else
+        return std::make_unique<RandomSkipListLevelTester<ElementType>>();
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::levelCount() const noexcept
+template <typename ElementType, typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::add(const ElementType& element)
 {
-    return 0;
+    restoreIfMovedFrom();
+
+    //find the node that the new one would follow on each level; on levels
+    //above the current top one, that's the head
+    Node* before[MAX_LEVELS];
+    std::fill_n(before + levels, MAX_LEVELS - levels, head);
+
+    Node* node = head;
+    for (unsigned int level = levels; level-- > 0; )
+    {
+        while (node->next()[level]->key().compare(element) < 0)
+            node = node->next()[level];
+        before[level] = node;
+    }
+
+    if (node->next()[0]->key().compare(element) == 0)
+        return;
+
+    unsigned int nodeLevels = chooseLevels(element);
+    Node* added = newNode(SkipListKind::Normal, nodeLevels, &element);
+
+    for (unsigned int level = 0; level < nodeLevels; level++)
+    {
+        added->next()[level] = before[level]->next()[level];
+        before[level]->next()[level] = added;
+    }
+
+    levels = std::max(levels, nodeLevels);
+    iSize++;
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+template <typename ElementType, typename NodeAllocator>
+template <typename KeyType>
+typename SkipListSet<ElementType, NodeAllocator>::Node* SkipListSet<ElementType, NodeAllocator>::findhelper(
+    const KeyType& key) const
 {
-    return 0;
+    //the search stops as soon as it sees the key on any level, rather than
+    //always going all the way down to level 0
+    if (head == nullptr)
+        return nullptr;
+
+    Node* node = head;
+    for (unsigned int level = levels; level-- > 0; )
+    {
+        Node* next = node->next()[level];
+        int comparison;
+
+        while ((comparison = next->key().compare(key)) < 0)
+        {
+            node = next;
+            next = node->next()[level];
+        }
+
+        if (comparison == 0)
+            return next;
+    }
+
+    return nullptr;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+template <typename ElementType, typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::contains(const ElementType& element) const
+{
+    return findhelper(element) != nullptr;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+template <typename KeyType, typename>
+bool SkipListSet<ElementType, NodeAllocator>::contains(const KeyType& key) const
 {
-    return false;
+    return findhelper(key) != nullptr;
 }
 
 
+template <typename ElementType, typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::contains(const char* chars, std::size_t length) const
+{
+    return contains(std::string_view{chars, length});
+}
+
 
-#endif
+template <typename ElementType, typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::size() const noexcept
+{
+    return iSize;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::levelCount() const noexcept
+{
+    return levels;
+}
 
+
+template <typename ElementType, typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::elementsOnLevel(unsigned int level) const noexcept
+{
+    if (level >= levels || head == nullptr)
+        return 0;
+
+    unsigned int count = 0;
+    for (Node* node = head->next()[level]; node != tail; node = node->next()[level])
+        count++;
+    return count;
+}
+
+
+template <typename ElementType, typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::isElementOnLevel(const ElementType& element, unsigned int level) const
+{
+    Node* node = findhelper(element);
+    return node != nullptr && level < node->levels;
+}
+
+
+
+#endif
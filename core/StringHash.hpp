@@ -0,0 +1,99 @@
+// StringHash.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// StringHash is a stateless function object that hashes strings.  It can
+// be passed to a HashSet as its hash function, either wrapped in the
+// HashSet's default std::function or, more efficiently, as the HashSet's
+// second template argument:
+//
+//     HashSet<std::string, StringHash> words{StringHash{}};
+//
+// in which case the hashing is inlined into every add() and contains().
+// Since it accepts a std::string_view, a std::string and a std::string_view
+// with the same characters always hash to the same value, which lets a
+// HashSet search for a std::string_view without building a std::string.
+//
+// The hash consumes eight bytes at a time, mixing each group of them with
+// a multiply and a shift, which is both faster and better distributed
+// than hashing one character at a time.  The bytes in each group are
+// always read as a little-endian number, whatever the platform's byte
+// order, so the hash is fully deterministic: the same string hashes to
+// the same value in every process, on every platform.
+
+#ifndef STRINGHASH_HPP
+#define STRINGHASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+
+struct StringHash
+{
+    unsigned int operator()(std::string_view s) const noexcept
+    {
+        return hash(s.data(), s.size());
+    }
+
+
+    static unsigned int hash(const char* chars, std::size_t length) noexcept
+    {
+        std::uint64_t h = 0x9E3779B97F4A7C15ull ^ length;
+
+        while (length >= 8)
+        {
+            h = mix(h ^ load8(chars));
+            chars += 8;
+            length -= 8;
+        }
+
+        if (length > 0)
+            h = mix(h ^ load(chars, length));
+
+        return static_cast<unsigned int>(h ^ (h >> 32));
+    }
+
+
+private:
+    // load8() reads eight bytes as a little-endian number, and load()
+    // reads fewer than that.  Compilers recognize load8() and turn it into
+    // a single load on little-endian platforms.
+    static std::uint64_t load8(const char* chars) noexcept
+    {
+        const unsigned char* b = reinterpret_cast<const unsigned char*>(chars);
+
+        return static_cast<std::uint64_t>(b[0])
+            | static_cast<std::uint64_t>(b[1]) << 8
+            | static_cast<std::uint64_t>(b[2]) << 16
+            | static_cast<std::uint64_t>(b[3]) << 24
+            | static_cast<std::uint64_t>(b[4]) << 32
+            | static_cast<std::uint64_t>(b[5]) << 40
+            | static_cast<std::uint64_t>(b[6]) << 48
+            | static_cast<std::uint64_t>(b[7]) << 56;
+    }
+
+
+    static std::uint64_t load(const char* chars, std::size_t length) noexcept
+    {
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < length; i++)
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(chars[i])) << (8 * i);
+        return word;
+    }
+
+
+    static std::uint64_t mix(std::uint64_t x) noexcept
+    {
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 31;
+        x *= 0x94D049BB133111EBull;
+        return x ^ (x >> 29);
+    }
+};
+
+
+
+#endif
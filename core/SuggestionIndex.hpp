@@ -0,0 +1,51 @@
+// SuggestionIndex.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SuggestionIndex is a structure built from the same words as a
+// dictionary, which can find every one of those words within a given edit
+// distance (as measured by editDistance()) of some other word, without
+// having to generate and look up every possible misspelling.  A
+// WordChecker can be given one, in which case it uses it to answer
+// findSuggestionsWithin().
+//
+// Searching an index is a const operation, and is safe to do from many
+// threads at once, as long as nothing is being added to it at the time.
+
+#ifndef SUGGESTIONINDEX_HPP
+#define SUGGESTIONINDEX_HPP
+
+#include <string>
+#include <vector>
+
+
+
+class SuggestionIndex
+{
+public:
+    virtual ~SuggestionIndex() noexcept = default;
+
+
+    // maxDistance() returns the largest edit distance the index can
+    // search, which is UNBOUNDED if there's no limit.
+    virtual unsigned int maxDistance() const noexcept = 0;
+
+
+    // suggestions() returns every word in the index, other than the given
+    // word itself, whose edit distance from the given word is no more than
+    // maxDistance, nearest first, with words at the same distance in
+    // alphabetical order.  A maxDistance larger than maxDistance() is
+    // treated as maxDistance(), so callers that need more than that have
+    // to look elsewhere.
+    virtual std::vector<std::string> suggestions(
+        const std::string& word, unsigned int maxDistance) const = 0;
+
+
+public:
+    static constexpr unsigned int UNBOUNDED = static_cast<unsigned int>(-1);
+};
+
+
+
+#endif
@@ -0,0 +1,72 @@
+// TestWords.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Helpers shared by the tests and the benchmarks of the structures that
+// store words and search for words near other words.  randomWords() makes
+// words from a given range of letters; a small range means that many of
+// them are within a few edits of one another.  wordsWithin() finds the
+// words within some edit distance of another by measuring the distance to
+// every one of them, which is the answer that the faster ways of searching
+// have to agree with.
+
+#ifndef TESTWORDS_HPP
+#define TESTWORDS_HPP
+
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "EditDistance.hpp"
+
+
+
+namespace TestWords
+{
+    inline std::vector<std::string> randomWords(
+        unsigned int count, unsigned int seed,
+        unsigned int minLength, unsigned int maxLength,
+        char firstLetter, char lastLetter)
+    {
+        std::default_random_engine engine{seed};
+        std::uniform_int_distribution<unsigned int> lengths{minLength, maxLength};
+        std::uniform_int_distribution<int> letters{firstLetter, lastLetter};
+
+        std::vector<std::string> words;
+        words.reserve(count);
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            std::string word(lengths(engine), ' ');
+            for (char& c : word)
+                c = static_cast<char>(letters(engine));
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    // wordsWithin() returns each distinct word in words, other than word
+    // itself, within maxDistance of it, in the order that suggestions are
+    // returned in.
+    inline std::vector<std::string> wordsWithin(
+        const std::vector<std::string>& words, const std::string& word, unsigned int maxDistance)
+    {
+        std::set<std::pair<unsigned int, std::string>> found;
+        for (const std::string& other : words)
+        {
+            unsigned int d = editDistance(word, other);
+            if (other != word && d <= maxDistance)
+                found.emplace(d, other);
+        }
+
+        return nearestFirst(std::vector<std::pair<unsigned int, std::string>>{found.begin(), found.end()});
+    }
+}
+
+
+
+#endif
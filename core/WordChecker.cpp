@@ -8,100 +8,487 @@
 
 #include "WordChecker.hpp"
 #include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include "BatchLookup.hpp"
+#include "DAWGSet.hpp"
+#include "EditDistance.hpp"
+#include "LevenshteinAutomaton.hpp"
+#include "StringHash.hpp"
 
-WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+
+namespace
 {
+    // forEachCandidate() calls visit with every candidate spelling that the
+    // five algorithms generate from the given word, in this order:
+    //
+    //   * swapping each adjacent pair of characters
+    //   * inserting each letter from 'A' through 'Z' at each position
+    //   * deleting each character
+    //   * replacing each character with each other letter from 'A' to 'Z'
+    //   * splitting the word in two by inserting a space at each position
+    //
+    // Every candidate is built in the same buffer.  Each strategy lays the
+    // buffer out once, after which moving from one candidate to the next
+    // changes only one or two characters, so generating a candidate never
+    // allocates memory or shifts the rest of the word around.
+    template <typename VisitFunction>
+    void forEachCandidate(const std::string& word, std::string& candidate, VisitFunction visit)
+    {
+        std::size_t n = word.size();
+        candidate.reserve(n + 1);
+
+        //swap
+        candidate = word;
+        for (std::size_t i = 0; i + 1 < n; i++)
+        {
+            std::swap(candidate[i], candidate[i + 1]);
+            visit(candidate);
+            std::swap(candidate[i], candidate[i + 1]);
+        }
+
+        // For inserting, the buffer holds the word with a one-character gap
+        // at position i; moving the gap right means copying one character
+        // of the word into the old gap.
+        auto insertEach = [&](char first, char last)
+        {
+            candidate.resize(n + 1);
+            for (std::size_t j = 0; j < n; j++)
+                candidate[j + 1] = word[j];
+
+            for (std::size_t i = 0; i <= n; i++)
+            {
+                for (char c = first; c <= last; c++)
+                {
+                    candidate[i] = c;
+                    visit(candidate);
+                }
+                if (i < n)
+                    candidate[i] = word[i];
+            }
+        };
+
+        //insert
+        insertEach('A', 'Z');
+
+        //deleting
+        if (n > 0)
+        {
+            candidate.resize(n - 1);
+            for (std::size_t j = 1; j < n; j++)
+                candidate[j - 1] = word[j];
+
+            for (std::size_t i = 0; i < n; i++)
+            {
+                visit(candidate);
+                if (i + 1 < n)
+                    candidate[i] = word[i];
+            }
+        }
+
+        //replacing
+        candidate = word;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (char c = 'A'; c <= 'Z'; c++)
+            {
+                if (c != word[i])
+                {
+                    candidate[i] = c;
+                    visit(candidate);
+                }
+            }
+            candidate[i] = word[i];
+        }
+
+        //splitting
+        insertEach(' ', ' ');
+    }
+
+
+    // A SuggestionList appends suggestions to a vector in the order they're
+    // found, skipping any that are already there.  Alongside the vector, it
+    // keeps a small open-addressed table of the suggestions' indices (plus
+    // one, so that zero can mark an empty cell), which means that checking
+    // for a duplicate costs one hash and usually one comparison, rather than
+    // a comparison with every suggestion found so far.
+    class SuggestionList
+    {
+    public:
+        explicit SuggestionList(std::vector<std::string>& suggestions)
+            : suggestions{suggestions}
+        {
+        }
+
+
+        void add(std::string_view suggestion)
+        {
+            // Table sizes are powers of two kept at least twice the number
+            // of suggestions, so there's always an empty cell to stop at.
+            if (table.size() < 2 * (suggestions.size() + 1))
+                grow();
+
+            std::size_t mask = table.size() - 1;
+            for (std::size_t i = StringHash{}(suggestion) & mask; ; i = (i + 1) & mask)
+            {
+                if (table[i] == 0)
+                {
+                    suggestions.emplace_back(suggestion);
+                    table[i] = static_cast<unsigned int>(suggestions.size());
+                    return;
+                }
+                else if (suggestions[table[i] - 1] == suggestion)
+                    return;
+            }
+        }
+
+
+    private:
+        void grow()
+        {
+            table.assign(table.empty() ? 16 : table.size() * 2, 0);
+
+            std::size_t mask = table.size() - 1;
+            for (std::size_t index = 0; index < suggestions.size(); index++)
+            {
+                std::size_t i = StringHash{}(suggestions[index]) & mask;
+                while (table[i] != 0)
+                    i = (i + 1) & mask;
+                table[i] = static_cast<unsigned int>(index + 1);
+            }
+        }
+
+
+    private:
+        std::vector<std::string>& suggestions;
+        std::vector<unsigned int> table;
+    };
+
+
+    // findBatched() generates every candidate for the given word up front,
+    // laid end to end in one string, and then looks all of them up in one
+    // call to containsMany(), so that the set can overlap their lookups.
+    void findBatched(
+        const BatchLookup<std::string_view>& words, const std::string& word,
+        SuggestionList& found)
+    {
+        std::size_t n = word.size();
+        std::string text;
+        std::vector<std::size_t> ends;
+        text.reserve(54 * (n + 1) * (n + 1));
+        ends.reserve(54 * (n + 1));
+
+        std::string candidate;
+        forEachCandidate(
+            word, candidate,
+            [&](const std::string& tmp)
+            {
+                text += tmp;
+                ends.push_back(text.size());
+            });
+
+        std::vector<std::string_view> keys;
+        keys.reserve(ends.size());
+
+        std::size_t start = 0;
+        for (std::size_t end : ends)
+        {
+            keys.emplace_back(text.data() + start, end - start);
+            start = end;
+        }
+
+        std::unique_ptr<bool[]> hits{new bool[keys.size()]};
+        words.containsMany(keys.data(), keys.size(), hits.get());
+
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            if (hits[i])
+                found.add(keys[i]);
+        }
+    }
+
+
+    // findGuided() finds the same suggestions as forEachCandidate() would,
+    // in the same order, by walking a DAWGSet alongside the word instead
+    // of building each candidate and looking it up.  Every candidate is
+    // the word's first i characters, then an edit, then the rest of the
+    // word; if no word in the set begins with those first i characters,
+    // then none of the candidates that edit at position i can be in the
+    // set, so they're skipped without being generated.  Inserting or
+    // replacing a character at i follows only the transitions that exist
+    // there, rather than trying all 26 letters, and the rest of each
+    // candidate is followed from wherever the edit leads, never from the
+    // root again.
+    void findGuided(const DAWGSet& words, const std::string& word, SuggestionList& found)
+    {
+        std::size_t n = word.size();
+        const char* chars = word.data();
+
+        // prefixes[i] is where the first i characters of the word lead, for
+        // as long as they lead anywhere.
+        std::vector<DAWGSet::Position> prefixes{words.root()};
+        for (std::size_t i = 0; i < n; i++)
+        {
+            DAWGSet::Position position = prefixes.back();
+            if (!words.advance(position, chars[i]))
+                break;
+
+            prefixes.push_back(position);
+        }
+
+        std::size_t reachable = prefixes.size();
+
+        auto restFrom = [&](DAWGSet::Position position, std::size_t start)
+        {
+            return words.containsFrom(position, chars + start, n - start);
+        };
+
+        std::string candidate;
+        auto addEdited = [&](std::size_t i, std::string_view edit, std::size_t resume)
+        {
+            candidate.assign(chars, i);
+            candidate.append(edit);
+            candidate.append(chars + resume, n - resume);
+            found.add(candidate);
+        };
+
+        //swap
+        for (std::size_t i = 0; i + 1 < n && i < reachable; i++)
+        {
+            DAWGSet::Position position = prefixes[i];
+            if (words.advance(position, chars[i + 1])
+                && words.advance(position, chars[i])
+                && restFrom(position, i + 2))
+            {
+                char swapped[] = {chars[i + 1], chars[i]};
+                addEdited(i, std::string_view{swapped, 2}, i + 2);
+            }
+        }
+
+        //insert
+        for (std::size_t i = 0; i <= n && i < reachable; i++)
+        {
+            words.forEachTransition(
+                prefixes[i],
+                [&](char c, DAWGSet::Position next)
+                {
+                    if (c >= 'A' && c <= 'Z' && restFrom(next, i))
+                        addEdited(i, std::string_view{&c, 1}, i);
+                });
+        }
+
+        //deleting
+        for (std::size_t i = 0; i < n && i < reachable; i++)
+        {
+            if (restFrom(prefixes[i], i + 1))
+                addEdited(i, std::string_view{}, i + 1);
+        }
+
+        //replacing
+        for (std::size_t i = 0; i < n && i < reachable; i++)
+        {
+            words.forEachTransition(
+                prefixes[i],
+                [&](char c, DAWGSet::Position next)
+                {
+                    if (c >= 'A' && c <= 'Z' && c != chars[i] && restFrom(next, i + 1))
+                        addEdited(i, std::string_view{&c, 1}, i + 1);
+                });
+        }
+
+        //splitting
+        for (std::size_t i = 0; i <= n && i < reachable; i++)
+        {
+            DAWGSet::Position position = prefixes[i];
+            if (words.advance(position, ' ') && restFrom(position, i))
+                addEdited(i, " ", i);
+        }
+    }
+
+
+    // An AutomatonSearch walks a DAWGSet in step with a LevenshteinAutomaton
+    // for a word, abandoning each transition after which the automaton can
+    // no longer match, and collects every word it matches (except the word
+    // itself), along with its distance.
+    struct AutomatonSearch
+    {
+        const DAWGSet& words;
+        const LevenshteinAutomaton& automaton;
+        const std::string& word;
+        std::string prefix;
+        std::vector<std::pair<unsigned int, std::string>> found;
+
+        // states[i] is the automaton's State after the first i characters
+        // of prefix; they're kept from one walk to the next, so that
+        // stepping reuses their memory rather than allocating.
+        std::vector<LevenshteinAutomaton::State> states;
+
+
+        void walk(const DAWGSet::Position& position)
+        {
+            std::size_t depth = prefix.size();
+
+            if (position.final && automaton.isMatch(states[depth]) && prefix != word)
+                found.emplace_back(automaton.distance(states[depth]), prefix);
+
+            if (states.size() == depth + 1)
+                states.emplace_back();
+
+            words.forEachTransition(
+                position,
+                [&](char c, const DAWGSet::Position& next)
+                {
+                    automaton.step(states[depth], c, states[depth + 1]);
+                    if (!automaton.canMatch(states[depth + 1]))
+                        return;
+
+                    prefix.push_back(c);
+                    walk(next);
+                    prefix.pop_back();
+                });
+        }
+    };
+
+
+    // findWithin() finds every word in a DAWGSet within maxDistance of the
+    // given word, nearest first, then in alphabetical order.
+    std::vector<std::string> findWithin(
+        const DAWGSet& words, const std::string& word, unsigned int maxDistance)
+    {
+        LevenshteinAutomaton automaton{word, maxDistance};
+        AutomatonSearch search{words, automaton, word, {}, {}, {automaton.start()}};
+
+        search.walk(words.root());
+
+        return nearestFirst(std::move(search.found));
+    }
 }
 
 
-bool WordChecker::wordExists(const std::string& word) const
+WordChecker::WordChecker(const Set<std::string>& words)
+    : words{words}, index{nullptr}, mode{SuggestionMode::Probe}
 {
-    return words.contains(word);
 }
 
 
-std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
+WordChecker::WordChecker(
+    const Set<std::string>& words, const SuggestionIndex& index, SuggestionMode mode)
+    : words{words}, index{&index}, mode{mode}
 {
-    // Nonsensical code because the compiler requires the member variables
-    // 'words' to be used somewhere, or else it becomes a warning (which
-    // turns into an error).
+}
 
-//setup
-std::vector<std::string> sl;
-if (words.contains(word))
-    return sl;
 
-std::string tmp = word;
-//swap
-for(int i = 0; i < word.size();i++)
+bool WordChecker::wordExists(const std::string& word) const
 {
-    std::swap(tmp[i],tmp[i+1]);
-    if(words.contains(tmp))
-    {
-        if(std::find(sl.begin(),sl.end(),tmp) == sl.end())
-            sl.push_back(tmp);
-    }
-tmp = word;
+    return words.contains(word);
 }
 
 
-//insert
-for(int i = 0; i<word.size()+1; i++)
+std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
 {
-    for(char j = 'A';j<='Z';j++)
+    std::vector<std::string> sl;
+    if (words.contains(word))
+        return sl;
+
+    // An index that can't search as far as one edit would find nothing,
+    // so the candidates are probed for instead.
+    if (mode == SuggestionMode::Index && index->maxDistance() >= 1)
+        return index->suggestions(word, 1);
+
+    SuggestionList found{sl};
+
+    // A DAWGSet is searched alongside the candidates as they're built.
+    // Sets that can look up a batch of keys at once, without building a
+    // std::string from each one, are given every candidate in one call;
+    // any other set is asked about each candidate as soon as it's
+    // generated, reusing one std::string for all of them.
+    if (auto dawg = dynamic_cast<const DAWGSet*>(&words))
     {
-        tmp.insert(i,1,j);
-        if (words.contains(tmp))
-        {
-            if(std::find(sl.begin(),sl.end(),tmp) == sl.end())
-                sl.push_back(tmp);
-        }
-    tmp = word;
+        findGuided(*dawg, word, found);
+        return sl;
     }
-}
-   
-//deleting
-for(int i = 0; i<word.size();i++) 
-{
-    tmp.erase(i,1);
-    if (words.contains(tmp))
+
+    auto batch = dynamic_cast<const BatchLookup<std::string_view>*>(&words);
+    if (batch != nullptr && batch->looksUpKeysDirectly())
     {
-        if(std::find(sl.begin(),sl.end(),tmp) == sl.end())
-            sl.push_back(tmp);
+        findBatched(*batch, word, found);
+        return sl;
     }
-    tmp = word;
+
+    std::string candidate;
+    forEachCandidate(
+        word, candidate,
+        [&](const std::string& tmp)
+        {
+            if (words.contains(tmp))
+                found.add(tmp);
+        });
+
+    return sl;
 }
 
-//replacing
-for(int i = 0; i<word.size(); i++)
+
+std::vector<std::string> WordChecker::findSuggestionsWithin(
+    const std::string& word, unsigned int maxDistance) const
 {
-    for(char j = 'A';j<='Z';j++)
+    if (words.contains(word))
+        return {};
+
+    // An index that can't search as far as was asked would leave out the
+    // furthest words, so the other ways of finding them are used instead.
+    if (index != nullptr && maxDistance <= index->maxDistance())
+        return index->suggestions(word, maxDistance);
+
+    if (auto dawg = dynamic_cast<const DAWGSet*>(&words))
+        return findWithin(*dawg, word, maxDistance);
+
+    // Each round generates the candidates of every string the round before
+    // generated, skipping strings that have already been seen.  The last
+    // round's candidates only need to be looked up, so they're not kept.
+    std::unordered_set<std::string> seen{word};
+    std::unordered_set<std::string> found;
+    std::vector<std::string> frontier{word};
+    std::string candidate;
+
+    for (unsigned int round = 1; round <= maxDistance; round++)
     {
-        tmp.erase(i,1);
-        tmp.insert(i,1,j);
-        if (words.contains(tmp))
+        bool last = round == maxDistance;
+        std::vector<std::string> next;
+
+        for (const std::string& s : frontier)
         {
-            if(std::find(sl.begin(),sl.end(),tmp) == sl.end())
-                sl.push_back(tmp);
+            forEachCandidate(
+                s, candidate,
+                [&](const std::string& tmp)
+                {
+                    if (!last && !seen.insert(tmp).second)
+                        return;
+
+                    if (!last)
+                        next.push_back(tmp);
+
+                    if (tmp != word && found.count(tmp) == 0 && words.contains(tmp))
+                        found.insert(tmp);
+                });
         }
-    tmp = word;
+
+        frontier = std::move(next);
     }
-}
-//splitting
-for(int i = 0; i<word.size()+1; i++)
-{
-    char c  = ' ';
-    tmp.insert(i,1,c);
-    if (words.contains(tmp))
+
+    // Two edits can reach a few words that editDistance() measures as
+    // further away (such as "ABC" from "CA", by swapping and then inserting
+    // between the swapped characters), so the distances are checked, too.
+    std::vector<std::pair<unsigned int, std::string>> ordered;
+    ordered.reserve(found.size());
+    for (const std::string& s : found)
     {
-        if(std::find(sl.begin(),sl.end(),tmp) == sl.end())
-            sl.push_back(tmp);
+        unsigned int d = editDistance(word, s, maxDistance);
+        if (d <= maxDistance)
+            ordered.emplace_back(d, s);
     }
-    tmp = word;
-    
-}
 
-return sl;
+    return nearestFirst(std::move(ordered));
 }
-
@@ -19,6 +19,22 @@
 #include <string>
 #include <vector>
 #include "Set.hpp"
+#include "SuggestionIndex.hpp"
+
+
+
+// SuggestionMode selects how a WordChecker with a SuggestionIndex finds
+// suggestions in findSuggestions(): by generating every candidate that
+// the five algorithms make and looking each one up in the Set (which lists
+// them in the order the algorithms find them), or by asking the index for
+// every word within one edit (which lists them nearest first, then in
+// alphabetical order, and for words made of letters, finds the same ones).
+
+enum class SuggestionMode
+{
+    Probe,
+    Index
+};
 
 
 
@@ -31,6 +47,15 @@ public:
     WordChecker(const Set<std::string>& words);
 
 
+    // This constructor also takes a SuggestionIndex built from the same
+    // words, which the WordChecker will store a reference to and use to
+    // find suggestions for findSuggestionsWithin(), and for findSuggestions()
+    // as well if the mode is SuggestionMode::Index.
+    WordChecker(
+        const Set<std::string>& words, const SuggestionIndex& index,
+        SuggestionMode mode = SuggestionMode::Probe);
+
+
     // wordExists() returns true if the given word is spelled correctly,
     // false otherwise.
     bool wordExists(const std::string& word) const;
@@ -42,8 +67,23 @@ public:
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
 
+    // findSuggestionsWithin() returns every word in the Set within the
+    // given edit distance of a misspelled word (or nothing, if the word is
+    // spelled correctly), nearest first, with words at the same distance
+    // in alphabetical order.  With a SuggestionIndex that can search that
+    // far, the index finds them.  Otherwise, a DAWGSet is searched by
+    // intersecting it with a LevenshteinAutomaton for the word, which works
+    // for any distance; any other Set has the five algorithms applied again
+    // to each candidate they generate, once per unit of distance, which,
+    // for words made of letters, gives the same answer much more slowly.
+    std::vector<std::string> findSuggestionsWithin(
+        const std::string& word, unsigned int maxDistance) const;
+
+
 private:
     const Set<std::string>& words;
+    const SuggestionIndex* index;
+    SuggestionMode mode;
 };
 
 
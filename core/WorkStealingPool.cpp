@@ -0,0 +1,146 @@
+// WorkStealingPool.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+
+
+WorkStealingPool::WorkStealingPool(unsigned int threadCount)
+    : count{threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())},
+      queues{new Queue[count]}
+{
+    // Thread 0 is whichever thread calls run(), so only the others are
+    // created here.
+    for (unsigned int self = 1; self < count; self++)
+        helpers.emplace_back([this, self]() { helperLoop(self); });
+}
+
+
+WorkStealingPool::~WorkStealingPool() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+
+    started.notify_all();
+
+    for (std::thread& helper : helpers)
+        helper.join();
+}
+
+
+unsigned int WorkStealingPool::threadCount() const noexcept
+{
+    return count;
+}
+
+
+void WorkStealingPool::run(unsigned int taskCount, const std::function<void(unsigned int)>& task)
+{
+    if (taskCount == 0)
+        return;
+
+    // The task has to be in place before any of the tasks are, since a
+    // helper that's just finishing the previous batch may take one as soon
+    // as it appears in a queue (and will see current, since it's set
+    // before the queue's lock is taken to add the task).
+    remaining.store(taskCount);
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        current = &task;
+        generation++;
+    }
+
+    // Deal the tasks out in contiguous runs, so that each thread starts
+    // with tasks that are next to each other (and that probably touch
+    // memory that's next to each other, too).
+    for (unsigned int q = 0; q < count; q++)
+    {
+        unsigned long long first = static_cast<unsigned long long>(taskCount) * q / count;
+        unsigned long long last = static_cast<unsigned long long>(taskCount) * (q + 1) / count;
+
+        std::lock_guard<std::mutex> lock{queues[q].mutex};
+        for (unsigned long long i = first; i < last; i++)
+            queues[q].tasks.push_back(static_cast<unsigned int>(i));
+    }
+
+    started.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock{mutex};
+    finished.wait(lock, [this]() { return remaining.load() == 0; });
+    current = nullptr;
+}
+
+
+void WorkStealingPool::helperLoop(unsigned int self)
+{
+    unsigned long long seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            started.wait(lock, [&]() { return stopping || generation != seen; });
+
+            if (stopping)
+                return;
+
+            seen = generation;
+        }
+
+        work(self);
+    }
+}
+
+
+void WorkStealingPool::work(unsigned int self)
+{
+    // current can only change once every task in the batch has finished,
+    // which can't happen while this thread holds one it hasn't run yet.
+    unsigned int task;
+    while (takeTask(self, task))
+    {
+        (*current)(task);
+
+        if (remaining.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            finished.notify_all();
+        }
+    }
+}
+
+
+bool WorkStealingPool::takeTask(unsigned int self, unsigned int& task)
+{
+    {
+        std::lock_guard<std::mutex> lock{queues[self].mutex};
+        if (!queues[self].tasks.empty())
+        {
+            task = queues[self].tasks.front();
+            queues[self].tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (unsigned int offset = 1; offset < count; offset++)
+    {
+        Queue& victim = queues[(self + offset) % count];
+
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
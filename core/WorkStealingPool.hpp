@@ -0,0 +1,89 @@
+// WorkStealingPool.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A WorkStealingPool is a fixed set of threads that can repeatedly be
+// given a batch of numbered tasks to run in parallel.  When a batch is
+// started, its tasks are dealt out in contiguous runs, one run to each
+// thread's own queue.  Each thread takes tasks from the front of its own
+// queue; a thread whose queue runs dry steals from the back of another
+// thread's queue instead, so threads that are given quicker tasks end up
+// helping the ones given slower tasks, rather than sitting idle.
+//
+// The thread that starts a batch is one of the pool's threads for the
+// duration of it, so a pool of one thread creates no threads at all and
+// simply runs every task itself.
+
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+class WorkStealingPool
+{
+public:
+    // Creates a pool of the given number of threads, including the one
+    // that will be calling run().  If threadCount is 0, the pool has one
+    // thread per core.
+    explicit WorkStealingPool(unsigned int threadCount = 0);
+
+    // Waits for the pool's threads to finish and cleans them up.
+    ~WorkStealingPool() noexcept;
+
+    WorkStealingPool(const WorkStealingPool& p) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool& p) = delete;
+
+
+    // threadCount() returns the number of threads in the pool, including
+    // the one that calls run().
+    unsigned int threadCount() const noexcept;
+
+
+    // run() calls task(i) once for every i from 0 to taskCount - 1,
+    // spread across the pool's threads, and returns once all of those
+    // calls have returned.  The task must not throw exceptions.  Only one
+    // thread at a time can call run() on a given pool.
+    void run(unsigned int taskCount, const std::function<void(unsigned int)>& task);
+
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<unsigned int> tasks;
+    };
+
+    void helperLoop(unsigned int self);
+    void work(unsigned int self);
+    bool takeTask(unsigned int self, unsigned int& task);
+
+private:
+    unsigned int count;
+    std::unique_ptr<Queue[]> queues;
+    std::vector<std::thread> helpers;
+
+    // These are protected by mutex.  Each call to run() starts a new
+    // generation, which wakes the helpers to work on it.
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    const std::function<void(unsigned int)>* current = nullptr;
+    unsigned long long generation = 0;
+    bool stopping = false;
+
+    std::atomic<unsigned int> remaining{0};
+};
+
+
+
+#endif
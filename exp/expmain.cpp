@@ -6,12 +6,1055 @@
 // Do whatever you'd like here.  This is intended to allow you to experiment
 // with your code, outside of the context of the broader program or Google
 // Test.
+//
+// What's here now is a set of small benchmarks, each of which prints how
+// long some operation takes on a synthetic list of dictionary-like words.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BKTree.hpp"
+#include "ConcurrentHashSet.hpp"
+#include "ConcurrentSkipListSet.hpp"
+#include "DAWGSet.hpp"
+#include "DeletionIndex.hpp"
+#include "DocumentChecker.hpp"
+#include "FrozenAVLSet.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+#include "StringHash.hpp"
+#include "TestWords.hpp"
+#include "WordChecker.hpp"
 
-int main()
+
+namespace
 {
+    std::vector<std::string> randomWords(
+        unsigned int count, unsigned int seed,
+        unsigned int minLength = 3, unsigned int maxLength = 14)
+    {
+        return TestWords::randomWords(count, seed, minLength, maxLength, 'A', 'Z');
+    }
 
 
-    return 0;
+    template <typename Function>
+    double millisecondsFor(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+
+    template <typename SetType>
+    void benchmarkLookups(
+        const std::string& name, SetType& set,
+        const std::vector<std::string>& words, const std::vector<std::string>& probes)
+    {
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        unsigned int found = 0;
+
+        double ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& probe : probes)
+                {
+                    if (set.contains(probe))
+                    {
+                        ++found;
+                    }
+                }
+            });
+
+        std::cout << name << ": " << (ms * 1000000.0 / probes.size())
+                  << " ns per lookup (" << found << " found)" << std::endl;
+    }
+
+
+    void benchmarkHashFunctions()
+    {
+        std::vector<std::string> words = randomWords(200000, 1);
+        std::vector<std::string> probes = randomWords(1000000, 2);
+        probes.insert(probes.end(), words.begin(), words.end());
+
+        HashSet<std::string> wrapped{StringHash{}, HashSetLayout::OpenAddressing};
+        benchmarkLookups("HashSet, std::function hash", wrapped, words, probes);
+
+        HashSet<std::string, StringHash> inlined{StringHash{}, HashSetLayout::OpenAddressing};
+        benchmarkLookups("HashSet, inlined StringHash", inlined, words, probes);
+    }
+
+
+    // misspell() replaces one character in each word with a different
+    // letter, so that most of them are no longer in the dictionary.
+    std::vector<std::string> misspell(std::vector<std::string> words, unsigned int seed)
+    {
+        std::mt19937 engine{seed};
+
+        for (std::string& word : words)
+        {
+            std::uniform_int_distribution<std::size_t> positions{0, word.size() - 1};
+            char& c = word[positions(engine)];
+            c = c == 'Z' ? 'A' : c + 1;
+        }
+
+        return words;
+    }
+
+
+    // copyingSuggestions() generates suggestions the way WordChecker used
+    // to, by copying the word back into a temporary string after every
+    // candidate and inserting or erasing characters in the middle of it.
+    std::vector<std::string> copyingSuggestions(const Set<std::string>& words, const std::string& word)
+    {
+        std::vector<std::string> sl;
+        std::string tmp = word;
+
+        auto check = [&]()
+        {
+            if (words.contains(tmp) && std::find(sl.begin(), sl.end(), tmp) == sl.end())
+                sl.push_back(tmp);
+            tmp = word;
+        };
+
+        for (std::size_t i = 0; i + 1 < word.size(); i++)
+        {
+            std::swap(tmp[i], tmp[i + 1]);
+            check();
+        }
+
+        for (std::size_t i = 0; i <= word.size(); i++)
+        {
+            for (char c = 'A'; c <= 'Z'; c++)
+            {
+                tmp.insert(i, 1, c);
+                check();
+            }
+        }
+
+        for (std::size_t i = 0; i < word.size(); i++)
+        {
+            tmp.erase(i, 1);
+            check();
+        }
+
+        for (std::size_t i = 0; i < word.size(); i++)
+        {
+            for (char c = 'A'; c <= 'Z'; c++)
+            {
+                tmp.erase(i, 1);
+                tmp.insert(i, 1, c);
+                check();
+            }
+        }
+
+        for (std::size_t i = 0; i <= word.size(); i++)
+        {
+            tmp.insert(i, 1, ' ');
+            check();
+        }
+
+        return sl;
+    }
+
+
+    // An UnbatchedSet forwards every lookup to another set, while hiding
+    // the fact that it can look up a batch of keys at once.
+    class UnbatchedSet : public Set<std::string>
+    {
+    public:
+        explicit UnbatchedSet(const Set<std::string>& set)
+            : set{set}
+        {
+        }
+
+        bool isImplemented() const noexcept override
+        {
+            return true;
+        }
+
+        void add(const std::string& /* element */) override
+        {
+        }
+
+        bool contains(const std::string& element) const override
+        {
+            return set.contains(element);
+        }
+
+        unsigned int size() const noexcept override
+        {
+            return set.size();
+        }
+
+    private:
+        const Set<std::string>& set;
+    };
+
+
+    template <typename SuggestFunction>
+    void benchmarkSuggestions(
+        const std::string& name, const std::vector<std::string>& misspellings,
+        SuggestFunction suggest)
+    {
+        unsigned int found = 0;
+
+        double ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& misspelling : misspellings)
+                {
+                    found += suggest(misspelling).size();
+                }
+            });
+
+        std::cout << name << ": " << (misspellings.size() * 1000.0 / ms)
+                  << " words per second (" << found << " suggestions)" << std::endl;
+    }
+
+
+    void benchmarkWordChecker()
+    {
+        std::vector<std::string> words = randomWords(200000, 3, 10, 20);
+        std::vector<std::string> misspellings = misspell(
+            std::vector<std::string>(words.begin(), words.begin() + 5000), 4);
+
+        HashSet<std::string, StringHash> dictionary{StringHash{}, HashSetLayout::OpenAddressing};
+        dictionary.reserve(words.size());
+
+        for (const std::string& word : words)
+        {
+            dictionary.add(word);
+        }
+
+        // The same hash function, wrapped in HashSet's default std::function,
+        // can't hash a std::string_view, so a WordChecker looks candidates
+        // up in this set one at a time rather than in batches.
+        HashSet<std::string> wrappedDictionary{StringHash{}, HashSetLayout::OpenAddressing};
+        wrappedDictionary.reserve(words.size());
+
+        for (const std::string& word : words)
+        {
+            wrappedDictionary.add(word);
+        }
+
+        UnbatchedSet unbatched{dictionary};
+        WordChecker unbatchedChecker{unbatched};
+        WordChecker checker{dictionary};
+        WordChecker wrappedChecker{wrappedDictionary};
+
+        benchmarkSuggestions(
+            "Suggestions, copying candidates", misspellings,
+            [&](const std::string& word) { return copyingSuggestions(dictionary, word); });
+
+        benchmarkSuggestions(
+            "Suggestions, WordChecker, one lookup at a time", misspellings,
+            [&](const std::string& word) { return unbatchedChecker.findSuggestions(word); });
+
+        benchmarkSuggestions(
+            "Suggestions, WordChecker, batched lookups", misspellings,
+            [&](const std::string& word) { return checker.findSuggestions(word); });
+
+        benchmarkSuggestions(
+            "Suggestions, WordChecker, std::function hash", misspellings,
+            [&](const std::string& word) { return wrappedChecker.findSuggestions(word); });
+    }
+
+
+    void benchmarkAVLSetLoading()
+    {
+        std::vector<std::string> words = randomWords(200000, 5);
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+
+        double addMs = millisecondsFor(
+            [&]()
+            {
+                AVLSet<std::string> s;
+
+                for (const std::string& word : words)
+                {
+                    s.add(word);
+                }
+            });
+
+        std::cout << "AVLSet, loading sorted words with add(): " << addMs << " ms" << std::endl;
+
+        double sortedMs = millisecondsFor(
+            [&]()
+            {
+                AVLSet<std::string> s = AVLSet<std::string>::fromSorted(words.begin(), words.end());
+            });
+
+        std::cout << "AVLSet, loading sorted words with fromSorted(): " << sortedMs << " ms" << std::endl;
+    }
+
+
+    template <typename SetType>
+    void benchmarkLoadAndDestroy(
+        const std::string& name, std::unique_ptr<SetType> set, const std::vector<std::string>& words)
+    {
+        double loadMs = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& word : words)
+                {
+                    set->add(word);
+                }
+            });
+
+        double destroyMs = millisecondsFor([&]() { set.reset(); });
+
+        std::cout << name << ": " << loadMs << " ms to load, "
+                  << destroyMs << " ms to destroy" << std::endl;
+    }
+
+
+    void benchmarkNodeAllocators()
+    {
+        std::vector<std::string> words = randomWords(200000, 6);
+
+        benchmarkLoadAndDestroy(
+            "AVLSet, heap nodes",
+            std::make_unique<AVLSet<std::string>>(), words);
+
+        benchmarkLoadAndDestroy(
+            "AVLSet, arena nodes",
+            std::make_unique<AVLSet<std::string, ArenaNodeAllocator>>(), words);
+
+        benchmarkLoadAndDestroy(
+            "HashSet, heap nodes",
+            std::make_unique<HashSet<std::string, StringHash>>(StringHash{}), words);
+
+        benchmarkLoadAndDestroy(
+            "HashSet, arena nodes",
+            std::make_unique<HashSet<std::string, StringHash, ArenaNodeAllocator>>(StringHash{}), words);
+
+        benchmarkLoadAndDestroy(
+            "SkipListSet, heap nodes",
+            std::make_unique<SkipListSet<std::string>>(), words);
+
+        benchmarkLoadAndDestroy(
+            "SkipListSet, arena nodes",
+            std::make_unique<SkipListSet<std::string, ArenaNodeAllocator>>(), words);
+    }
+
+
+    void benchmarkSkipListLevelTesters()
+    {
+        std::vector<std::string> words = randomWords(200000, 14);
+
+        benchmarkLoadAndDestroy(
+            "SkipListSet, random levels",
+            std::make_unique<SkipListSet<std::string>>(), words);
+
+        benchmarkLoadAndDestroy(
+            "SkipListSet, hashed levels",
+            std::make_unique<SkipListSet<std::string>>(
+                std::make_unique<HashSkipListLevelTester<std::string, StringHash>>(StringHash{})),
+            words);
+    }
+
+
+    template <typename SetType>
+    void benchmarkReadOnlyLookups(
+        const std::string& name, const SetType& set, const std::vector<std::string>& probes)
+    {
+        unsigned int found = 0;
+
+        double ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& probe : probes)
+                {
+                    if (set.contains(probe))
+                    {
+                        ++found;
+                    }
+                }
+            });
+
+        std::cout << name << ": " << (ms * 1000000.0 / probes.size())
+                  << " ns per lookup (" << found << " found)" << std::endl;
+    }
+
+
+    void benchmarkFrozenAVLSet()
+    {
+        std::vector<std::string> words = randomWords(200000, 7);
+        std::vector<std::string> probes = randomWords(100000, 8);
+        probes.insert(probes.end(), words.begin(), words.begin() + 100000);
+        std::shuffle(probes.begin(), probes.end(), std::mt19937{9});
+
+        AVLSet<std::string> s;
+
+        for (const std::string& word : words)
+        {
+            s.add(word);
+        }
+
+        FrozenAVLSet<std::string> frozen;
+
+        double freezeMs = millisecondsFor([&]() { frozen = s.freeze(); });
+
+        std::cout << "FrozenAVLSet, freezing: " << freezeMs << " ms" << std::endl;
+
+        benchmarkReadOnlyLookups("AVLSet", s, probes);
+        benchmarkReadOnlyLookups("FrozenAVLSet", frozen, probes);
+    }
+
+
+    void benchmarkAVLSetSwaps()
+    {
+        // Swapping a freshly loaded set into place should take the same
+        // (tiny) amount of time no matter how big the set is.
+        for (unsigned int count : {1000, 10000, 100000})
+        {
+            std::vector<std::string> words = randomWords(count, 10);
+            AVLSet<std::string> serving;
+            AVLSet<std::string> loaded;
+
+            for (const std::string& word : words)
+            {
+                loaded.add(word);
+            }
+
+            double ms = millisecondsFor([&]() { serving = std::move(loaded); });
+
+            std::cout << "AVLSet, move-assigning " << serving.size() << " words: "
+                      << (ms * 1000000.0) << " ns" << std::endl;
+        }
+    }
+
+
+    void benchmarkConcurrentSkipListSet()
+    {
+        // With one writer adding new words the whole time, measure how many
+        // lookups per second readers complete as more of them are added.
+        std::vector<std::string> words = randomWords(100000, 11);
+        std::vector<std::string> added = randomWords(100000, 12);
+        std::vector<std::string> probes = randomWords(50000, 13);
+        probes.insert(probes.end(), words.begin(), words.begin() + 50000);
+
+        unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int readers = 1; readers <= cores; readers *= 2)
+        {
+            ConcurrentSkipListSet<std::string> s;
+
+            for (const std::string& word : words)
+            {
+                s.add(word);
+            }
+
+            std::atomic<bool> done{false};
+            std::atomic<unsigned long long> lookups{0};
+
+            std::thread writer{
+                [&]()
+                {
+                    for (const std::string& word : added)
+                    {
+                        if (done.load(std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+
+                        s.add(word);
+                    }
+                }};
+
+            std::vector<std::thread> threads;
+
+            double ms = millisecondsFor(
+                [&]()
+                {
+                    for (unsigned int reader = 0; reader < readers; ++reader)
+                    {
+                        threads.emplace_back(
+                            [&]()
+                            {
+                                unsigned long long count = 0;
+
+                                for (const std::string& probe : probes)
+                                {
+                                    s.contains(probe);
+                                    ++count;
+                                }
+
+                                lookups.fetch_add(count);
+                            });
+                    }
+
+                    for (std::thread& thread : threads)
+                    {
+                        thread.join();
+                    }
+                });
+
+            done.store(true);
+            writer.join();
+
+            std::cout << "ConcurrentSkipListSet, " << readers << " reader(s) and 1 writer: "
+                      << (lookups.load() / ms / 1000.0) << " million lookups per second" << std::endl;
+        }
+
+        // Then measure how many adds per second several writers complete
+        // together, each adding an equal share of the new words.
+        for (unsigned int writers = 1; writers <= cores; writers *= 2)
+        {
+            ConcurrentSkipListSet<std::string> s;
+
+            for (const std::string& word : words)
+            {
+                s.add(word);
+            }
+
+            std::vector<std::thread> threads;
+
+            double ms = millisecondsFor(
+                [&]()
+                {
+                    for (unsigned int writer = 0; writer < writers; ++writer)
+                    {
+                        threads.emplace_back(
+                            [&, writer]()
+                            {
+                                for (std::size_t i = writer; i < added.size(); i += writers)
+                                {
+                                    s.add(added[i]);
+                                }
+                            });
+                    }
+
+                    for (std::thread& thread : threads)
+                    {
+                        thread.join();
+                    }
+                });
+
+            std::cout << "ConcurrentSkipListSet, " << writers << " writer(s): "
+                      << (added.size() / ms / 1000.0) << " million adds per second" << std::endl;
+        }
+    }
+
+
+    void benchmarkConcurrentHashSet()
+    {
+        // Build one dictionary from several word lists, giving each thread
+        // an equal share of the lists.
+        constexpr unsigned int listCount = 8;
+        std::vector<std::vector<std::string>> lists;
+
+        for (unsigned int list = 0; list < listCount; ++list)
+        {
+            lists.push_back(randomWords(100000, 20 + list));
+        }
+
+        double singleMs = millisecondsFor(
+            [&]()
+            {
+                HashSet<std::string, StringHash> s{StringHash{}, HashSetLayout::OpenAddressing};
+
+                for (const std::vector<std::string>& list : lists)
+                {
+                    for (const std::string& word : list)
+                    {
+                        s.add(word);
+                    }
+                }
+            });
+
+        std::cout << "HashSet, merging " << listCount << " lists: " << singleMs << " ms" << std::endl;
+
+        unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int threadCount = 1; threadCount <= cores; threadCount *= 2)
+        {
+            double ms = millisecondsFor(
+                [&]()
+                {
+                    ConcurrentHashSet<std::string, StringHash> s{StringHash{}};
+                    std::vector<std::thread> threads;
+
+                    for (unsigned int t = 0; t < threadCount; ++t)
+                    {
+                        threads.emplace_back(
+                            [&, t]()
+                            {
+                                for (unsigned int list = t; list < listCount; list += threadCount)
+                                {
+                                    for (const std::string& word : lists[list])
+                                    {
+                                        s.add(word);
+                                    }
+                                }
+                            });
+                    }
+
+                    for (std::thread& thread : threads)
+                    {
+                        thread.join();
+                    }
+                });
+
+            std::cout << "ConcurrentHashSet, merging " << listCount << " lists with "
+                      << threadCount << " thread(s): " << ms << " ms" << std::endl;
+        }
+    }
+
+
+    void benchmarkDocumentChecker()
+    {
+        // The documents are mostly dictionary words, with one in ten
+        // misspelled, and plenty of words repeated between them.
+        std::vector<std::string> words = randomWords(100000, 30);
+        std::vector<std::string> misspellings = misspell(words, 31);
+        HashSet<std::string, StringHash> set{StringHash{}, HashSetLayout::OpenAddressing};
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        WordChecker checker{set};
+
+        std::mt19937 engine{32};
+        std::uniform_int_distribution<std::size_t> picks{0, 9999};
+        std::vector<std::string> documents(200);
+
+        for (std::string& document : documents)
+        {
+            for (unsigned int i = 0; i < 500; ++i)
+            {
+                std::size_t pick = picks(engine);
+                document += i % 10 == 0 ? misspellings[pick] : words[pick];
+                document += ' ';
+            }
+        }
+
+        unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int threadCount = 1; threadCount <= cores; threadCount *= 2)
+        {
+            DocumentChecker documentChecker{checker, threadCount};
+
+            double ms = millisecondsFor([&]() { documentChecker.checkAll(documents); });
+
+            std::cout << "DocumentChecker, " << documents.size() << " documents with "
+                      << threadCount << " thread(s): " << ms << " ms" << std::endl;
+        }
+    }
+
+
+    void benchmarkDeletionIndex()
+    {
+        std::vector<std::string> words = randomWords(100000, 40);
+        std::vector<std::string> misspellings = misspell(words, 41);
+        HashSet<std::string, StringHash> set{StringHash{}, HashSetLayout::OpenAddressing};
+        DeletionIndex index;
+
+        double ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& word : words)
+                {
+                    set.add(word);
+                }
+            });
+
+        std::cout << "Loading " << words.size() << " words into a HashSet: " << ms << " ms" << std::endl;
+
+        ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& word : words)
+                {
+                    index.add(word);
+                }
+
+                // The first search sorts the index, which is part of building it.
+                index.suggestions("", 0);
+            });
+
+        std::cout << "Building a DeletionIndex of " << index.deletionCount() << " deletions: "
+                  << ms << " ms" << std::endl;
+
+        WordChecker probing{set};
+        WordChecker indexed{set, index};
+
+        // Probing every candidate of every candidate is slow enough that
+        // only a few words are timed that way.
+        for (unsigned int distance = 1; distance <= 2; ++distance)
+        {
+            unsigned int probed = distance == 1 ? 1000 : 20;
+
+            double probingMs = millisecondsFor(
+                [&]()
+                {
+                    for (unsigned int i = 0; i < probed; ++i)
+                    {
+                        probing.findSuggestionsWithin(misspellings[i], distance);
+                    }
+                });
+
+            double indexedMs = millisecondsFor(
+                [&]()
+                {
+                    for (unsigned int i = 0; i < 1000; ++i)
+                    {
+                        indexed.findSuggestionsWithin(misspellings[i], distance);
+                    }
+                });
+
+            std::cout << "Suggestions within distance " << distance << ", probing: "
+                      << probingMs / probed << " ms per word" << std::endl;
+            std::cout << "Suggestions within distance " << distance << ", DeletionIndex: "
+                      << indexedMs / 1000 << " ms per word" << std::endl;
+        }
+    }
+
+    void benchmarkBKTree()
+    {
+        std::vector<std::string> words = randomWords(100000, 50, 3, 16);
+        HashSet<std::string, StringHash> set{StringHash{}, HashSetLayout::OpenAddressing};
+        BKTree tree;
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        double ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& word : words)
+                {
+                    tree.add(word);
+                }
+            });
+
+        std::cout << "Building a BKTree of " << tree.size() << " words (height " << tree.height()
+                  << "): " << ms << " ms" << std::endl;
+
+        WordChecker probing{set};
+        WordChecker indexed{set, tree, SuggestionMode::Index};
+
+        // Each length is timed on misspellings of the dictionary's words of
+        // that length.  Probing at distance 2 is slow enough that it's
+        // timed on only a few of them.
+        for (std::size_t length = 4; length <= 16; length += 4)
+        {
+            std::vector<std::string> ofLength;
+            for (const std::string& word : words)
+            {
+                if (word.size() == length && ofLength.size() < 100)
+                {
+                    ofLength.push_back(word);
+                }
+            }
+
+            std::vector<std::string> misspellings = misspell(ofLength, 51);
+
+            double probe1 = millisecondsFor(
+                [&]()
+                {
+                    for (const std::string& word : misspellings)
+                    {
+                        probing.findSuggestions(word);
+                    }
+                });
+
+            double tree1 = millisecondsFor(
+                [&]()
+                {
+                    for (const std::string& word : misspellings)
+                    {
+                        indexed.findSuggestions(word);
+                    }
+                });
+
+            double probe2 = millisecondsFor(
+                [&]()
+                {
+                    for (unsigned int i = 0; i < 5; ++i)
+                    {
+                        probing.findSuggestionsWithin(misspellings[i], 2);
+                    }
+                });
+
+            unsigned long long measured = 0;
+            double tree2 = millisecondsFor(
+                [&]()
+                {
+                    for (const std::string& word : misspellings)
+                    {
+                        unsigned int count;
+                        tree.suggestions(word, 2, count);
+                        measured += count;
+                    }
+                });
+
+            std::cout << "Length " << length << ", distance 1: probing "
+                      << probe1 / misspellings.size() << " ms, BKTree "
+                      << tree1 / misspellings.size() << " ms per word" << std::endl;
+            std::cout << "Length " << length << ", distance 2: probing "
+                      << probe2 / 5 << " ms, BKTree "
+                      << tree2 / misspellings.size() << " ms per word ("
+                      << measured / misspellings.size() << " words measured)" << std::endl;
+        }
+    }
+
+    // englishLikeWords() makes words the way English does, by attaching
+    // common suffixes to stems, which gives them shared prefixes and
+    // suffixes like those of a real dictionary.
+    std::vector<std::string> englishLikeWords(unsigned int stemCount, unsigned int seed)
+    {
+        const char* suffixes[] = {
+            "", "S", "ED", "ING", "ER", "ERS", "LY", "NESS", "ABLE", "ATION", "ATIONS", "FUL"};
+
+        std::vector<std::string> stems = randomWords(stemCount, seed, 3, 8);
+        std::mt19937 engine{seed + 1};
+        std::bernoulli_distribution uses{0.7};
+
+        std::vector<std::string> words;
+        for (const std::string& stem : stems)
+        {
+            for (const char* suffix : suffixes)
+            {
+                if (uses(engine))
+                {
+                    words.push_back(stem + suffix);
+                }
+            }
+        }
+
+        return words;
+    }
+
+
+    void benchmarkDAWGSet()
+    {
+        std::vector<std::string> words = englishLikeWords(12000, 60);
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+
+        std::vector<std::string> probes = misspell(words, 61);
+        probes.insert(probes.end(), words.begin(), words.end());
+        std::shuffle(probes.begin(), probes.end(), std::mt19937{62});
+
+        // The words are short enough that std::string keeps them within
+        // itself, so the HashSet's memoryUsage() accounts for them, too.
+        HashSet<std::string, StringHash> hashSet{StringHash{}};
+
+        for (const std::string& word : words)
+        {
+            hashSet.add(word);
+        }
+
+        DAWGSet dawg;
+
+        double ms = millisecondsFor(
+            [&]()
+            {
+                for (const std::string& word : words)
+                {
+                    dawg.add(word);
+                }
+
+                dawg.compact();
+            });
+
+        std::cout << "HashSet of " << words.size() << " English-like words: "
+                  << hashSet.memoryUsage() / 1024 << " KiB" << std::endl;
+        std::cout << "DAWGSet of the same words: " << dawg.memoryUsage() / 1024 << " KiB ("
+                  << dawg.stateCount() << " states, " << dawg.transitionCount()
+                  << " transitions), built in " << ms << " ms" << std::endl;
+
+        benchmarkReadOnlyLookups("HashSet", hashSet, probes);
+        benchmarkReadOnlyLookups("DAWGSet", dawg, probes);
+    }
+
+    // A ForwardingSet hides which kind of set it forwards lookups to, so
+    // that a WordChecker given one can only probe it word by word.
+    class ForwardingSet : public Set<std::string>
+    {
+    public:
+        explicit ForwardingSet(const Set<std::string>& set)
+            : set{set}
+        {
+        }
+
+        bool isImplemented() const noexcept override
+        {
+            return true;
+        }
+
+        void add(const std::string& /* element */) override
+        {
+        }
+
+        bool contains(const std::string& element) const override
+        {
+            return set.contains(element);
+        }
+
+        unsigned int size() const noexcept override
+        {
+            return set.size();
+        }
+
+    private:
+        const Set<std::string>& set;
+    };
+
+
+    void benchmarkGuidedSuggestions()
+    {
+        std::vector<std::string> words = englishLikeWords(12000, 70);
+        HashSet<std::string, StringHash> hashSet{StringHash{}, HashSetLayout::OpenAddressing};
+
+        for (const std::string& word : words)
+        {
+            hashSet.add(word);
+        }
+
+        DAWGSet dawg{words};
+        dawg.compact();
+        ForwardingSet probedDawg{dawg};
+
+        WordChecker hashChecker{hashSet};
+        WordChecker probingChecker{probedDawg};
+        WordChecker guidedChecker{dawg};
+
+        for (std::size_t length = 4; length <= 13; length += 3)
+        {
+            std::vector<std::string> ofLength;
+            for (const std::string& word : words)
+            {
+                if (word.size() == length && ofLength.size() < 500)
+                {
+                    ofLength.push_back(word);
+                }
+            }
+
+            std::vector<std::string> misspellings = misspell(ofLength, 71);
+
+            auto perWord = [&](const WordChecker& checker)
+            {
+                double ms = millisecondsFor(
+                    [&]()
+                    {
+                        for (const std::string& word : misspellings)
+                        {
+                            checker.findSuggestions(word);
+                        }
+                    });
+
+                return ms * 1000.0 / misspellings.size();
+            };
+
+            std::cout << "Suggestions for length " << length << " ("
+                      << 54 * length + 25 << " candidates): HashSet probing "
+                      << perWord(hashChecker) << " us, DAWGSet probing "
+                      << perWord(probingChecker) << " us, DAWGSet guided "
+                      << perWord(guidedChecker) << " us per word" << std::endl;
+        }
+    }
+
+    void benchmarkLevenshteinAutomaton()
+    {
+        std::vector<std::string> words = englishLikeWords(12000, 80);
+        std::vector<std::string> misspellings = misspell(words, 81);
+        std::shuffle(misspellings.begin(), misspellings.end(), std::mt19937{82});
+        misspellings.resize(500);
+
+        HashSet<std::string, StringHash> hashSet{StringHash{}, HashSetLayout::OpenAddressing};
+        DeletionIndex index;
+
+        for (const std::string& word : words)
+        {
+            hashSet.add(word);
+            index.add(word);
+        }
+
+        DAWGSet dawg{words};
+        dawg.compact();
+
+        WordChecker indexed{hashSet, index};
+        WordChecker automaton{dawg};
+
+        // The index sorts its entries the first time it's asked for
+        // suggestions, which shouldn't be counted against either distance.
+        index.suggestions(misspellings.front(), 1);
+
+        for (unsigned int distance = 1; distance <= 3; ++distance)
+        {
+            unsigned long long found = 0;
+
+            double automatonMs = millisecondsFor(
+                [&]()
+                {
+                    for (const std::string& word : misspellings)
+                    {
+                        found += automaton.findSuggestionsWithin(word, distance).size();
+                    }
+                });
+
+            std::cout << "Suggestions within distance " << distance << ", DAWGSet and automaton: "
+                      << automatonMs * 1000.0 / misspellings.size() << " us per word ("
+                      << found << " found)";
+
+            if (distance <= index.maxDistance())
+            {
+                double indexedMs = millisecondsFor(
+                    [&]()
+                    {
+                        for (const std::string& word : misspellings)
+                        {
+                            indexed.findSuggestionsWithin(word, distance);
+                        }
+                    });
+
+                std::cout << ", DeletionIndex: " << indexedMs * 1000.0 / misspellings.size()
+                          << " us per word";
+            }
+
+            std::cout << std::endl;
+        }
+    }
 }
 
+
+int main()
+{
+    benchmarkHashFunctions();
+    benchmarkWordChecker();
+    benchmarkAVLSetLoading();
+    benchmarkNodeAllocators();
+    benchmarkSkipListLevelTesters();
+    benchmarkFrozenAVLSet();
+    benchmarkAVLSetSwaps();
+    benchmarkConcurrentSkipListSet();
+    benchmarkConcurrentHashSet();
+    benchmarkDocumentChecker();
+    benchmarkDeletionIndex();
+    benchmarkBKTree();
+    benchmarkDAWGSet();
+    benchmarkGuidedSuggestions();
+    benchmarkLevenshteinAutomaton();
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+// AVLSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the AVLSet functionality beyond what the sanity-checking
+// tests cover.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+TEST(AVLSet_Tests, canLookUpStringViewsWithoutBuildingStrings)
+{
+    AVLSet<std::string> s;
+    s.add("HELLO");
+    s.add("THERE");
+    s.add("BOO");
+
+    std::string_view text{"BOOHELLOTHERE"};
+
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_TRUE(s.contains(text.substr(3, 5)));
+    EXPECT_TRUE(s.contains(text.data() + 8, 5));
+    EXPECT_FALSE(s.contains(text));
+    EXPECT_FALSE(s.contains(text.data(), 2));
+    EXPECT_TRUE(s.contains("HELLO"));
+}
+
+
+TEST(AVLSet_Tests, containsManyAgreesWithContains)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 500; i += 7)
+    {
+        s.add(i);
+    }
+
+    int keys[100];
+    bool found[100];
+
+    for (int i = 0; i < 100; ++i)
+    {
+        keys[i] = 500 - i * 5;
+    }
+
+    s.containsMany(keys, 100, found);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(s.contains(keys[i]), found[i]);
+        EXPECT_EQ(keys[i] % 7 == 0, found[i]);
+    }
+}
+
+
+TEST(AVLSet_Tests, ascendingInsertionsBuildAPerfectTree)
+{
+    AVLSet<int> balanced;
+    AVLSet<int> notBalanced{false};
+
+    for (int i = 1; i <= 1023; ++i)
+    {
+        balanced.add(i);
+        notBalanced.add(i);
+    }
+
+    EXPECT_EQ(1023, balanced.size());
+    EXPECT_EQ(9, balanced.height());
+    EXPECT_EQ(1022, notBalanced.height());
+
+    int expected = 1;
+    bool inOrder = true;
+    balanced.inorder([&](const int& element) { inOrder = inOrder && element == expected++; });
+    EXPECT_TRUE(inOrder);
+}
+
+
+TEST(AVLSet_Tests, heightStaysLogarithmicWithZigZagInsertions)
+{
+    AVLSet<int> s;
+
+    // Alternating between the low and high ends forces double rotations.
+    for (int i = 0; i < 500; ++i)
+    {
+        s.add(i);
+        s.add(1000 - i);
+        s.add(500 + (i * 37) % 500);
+    }
+
+    EXPECT_EQ(1001, s.size());
+    EXPECT_LE(s.height(), 14);
+
+    for (int i = 0; i <= 1000; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+
+    AVLSet<int> copy{s};
+    EXPECT_EQ(s.height(), copy.height());
+}
+
+
+TEST(AVLSet_Tests, fromSortedBuildsAPerfectlyBalancedTree)
+{
+    std::vector<int> elements;
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        elements.push_back(i * 2);
+    }
+
+    AVLSet<int> s = AVLSet<int>::fromSorted(elements.begin(), elements.end());
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_EQ(9, s.height());
+
+    for (int i = 0; i <= 2001; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0 && i > 0, s.contains(i));
+    }
+
+    std::vector<int> inElements;
+    s.inorder([&](const int& element) { inElements.push_back(element); });
+    EXPECT_EQ(elements, inElements);
+
+    s.add(2001);
+    EXPECT_TRUE(s.contains(2001));
+    EXPECT_EQ(1001, s.size());
+}
+
+
+TEST(AVLSet_Tests, fromSortedFallsBackWhenNotSorted)
+{
+    std::vector<std::string> words{"BOO", "HELLO", "HELLO", "THERE", "APPLE"};
+
+    AVLSet<std::string> s = AVLSet<std::string>::fromSorted(words.begin(), words.end());
+
+    EXPECT_EQ(4, s.size());
+    EXPECT_EQ(2, s.height());
+    EXPECT_TRUE(s.contains("APPLE"));
+    EXPECT_TRUE(s.contains("HELLO"));
+    EXPECT_FALSE(s.contains("HELL"));
+}
+
+
+TEST(AVLSet_Tests, fromSortedHandlesEmptyRanges)
+{
+    std::vector<int> elements;
+
+    AVLSet<int> s = AVLSet<int>::fromSorted(elements.begin(), elements.end());
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_EQ(-1, s.height());
+}
+
+
+TEST(AVLSet_Tests, canAllocateNodesFromAnArena)
+{
+    AVLSet<std::string, ArenaNodeAllocator> s;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    AVLSet<std::string, ArenaNodeAllocator> copy{s};
+    AVLSet<std::string, ArenaNodeAllocator> moved{std::move(s)};
+    AVLSet<std::string, ArenaNodeAllocator> assigned;
+    assigned.add("GONE");
+    assigned = copy;
+
+    EXPECT_EQ(5000, moved.size());
+    EXPECT_FALSE(assigned.contains("GONE"));
+
+    for (int i = 0; i < 5000; i += 10)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        EXPECT_TRUE(copy.contains(word));
+        EXPECT_TRUE(moved.contains(word));
+        EXPECT_TRUE(assigned.contains(word));
+    }
+
+    std::vector<int> elements{1, 2, 3, 4, 5, 6, 7};
+    AVLSet<int, ArenaNodeAllocator> sorted =
+        AVLSet<int, ArenaNodeAllocator>::fromSorted(elements.begin(), elements.end());
+
+    EXPECT_EQ(2, sorted.height());
+    EXPECT_TRUE(sorted.contains(7));
+}
+
+
+TEST(AVLSet_Tests, copiesKeepSizeAndBalancing)
+{
+    AVLSet<int> s{false};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+    }
+
+    AVLSet<int> copy{s};
+
+    EXPECT_EQ(10, copy.size());
+
+    copy.add(10);
+
+    EXPECT_EQ(11, copy.size());
+    EXPECT_EQ(10, copy.height());
+
+    AVLSet<int> assigned;
+    assigned.add(100);
+    assigned = s;
+
+    EXPECT_EQ(10, assigned.size());
+    EXPECT_FALSE(assigned.contains(100));
+
+    assigned.add(10);
+
+    EXPECT_EQ(10, assigned.height());
+
+    assigned = assigned;
+
+    EXPECT_EQ(11, assigned.size());
+    EXPECT_TRUE(assigned.contains(10));
+}
+
+
+TEST(AVLSet_Tests, movesTakeTheTreeSizeAndBalancing)
+{
+    AVLSet<int> s{false};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+    }
+
+    AVLSet<int> moved{std::move(s)};
+
+    EXPECT_EQ(10, moved.size());
+    EXPECT_EQ(9, moved.height());
+
+    AVLSet<int> assigned;
+    assigned.add(100);
+    assigned = std::move(moved);
+
+    EXPECT_EQ(10, assigned.size());
+    EXPECT_FALSE(assigned.contains(100));
+
+    assigned.add(10);
+
+    EXPECT_EQ(11, assigned.size());
+    EXPECT_EQ(10, assigned.height());
+}
+
+
+TEST(AVLSet_Tests, moveAssigningFromAnArenaTakesItsNodes)
+{
+    AVLSet<std::string, ArenaNodeAllocator> loaded;
+    AVLSet<std::string, ArenaNodeAllocator> serving;
+    serving.add("OLD");
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        loaded.add("WORD" + std::to_string(i));
+    }
+
+    serving = std::move(loaded);
+
+    EXPECT_EQ(1000, serving.size());
+    EXPECT_FALSE(serving.contains("OLD"));
+    EXPECT_TRUE(serving.contains("WORD999"));
+
+    serving.add("NEW");
+
+    EXPECT_TRUE(serving.contains("NEW"));
+}
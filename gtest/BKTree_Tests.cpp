@@ -0,0 +1,162 @@
+// BKTree_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for BKTree, and for the damerauLevenshteinDistance() function
+// that it arranges its words by.
+
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BKTree.hpp"
+#include "DeletionIndex.hpp"
+#include "EditDistance.hpp"
+#include "TestWords.hpp"
+
+
+namespace
+{
+    std::vector<std::string> randomWords(unsigned int count, unsigned int seed)
+    {
+        return TestWords::randomWords(count, seed, 1, 7, 'A', 'E');
+    }
+}
+
+
+TEST(BKTree_Tests, damerauLevenshteinAllowsEditsBetweenSwappedCharacters)
+{
+    EXPECT_EQ(0u, damerauLevenshteinDistance("CAT", "CAT"));
+    EXPECT_EQ(1u, damerauLevenshteinDistance("CAT", "ACT"));
+    EXPECT_EQ(3u, damerauLevenshteinDistance("", "CAT"));
+    EXPECT_EQ(3u, damerauLevenshteinDistance("KITTEN", "SITTING"));
+
+    EXPECT_EQ(2u, damerauLevenshteinDistance("CA", "ABC"));
+    EXPECT_EQ(3u, editDistance("CA", "ABC"));
+}
+
+
+TEST(BKTree_Tests, damerauLevenshteinIsAMetricNoLargerThanEditDistance)
+{
+    std::vector<std::string> words = randomWords(40, 22);
+
+    for (const std::string& a : words)
+    {
+        for (const std::string& b : words)
+        {
+            unsigned int ab = damerauLevenshteinDistance(a, b);
+            ASSERT_EQ(ab, damerauLevenshteinDistance(b, a));
+            ASSERT_LE(ab, editDistance(a, b));
+
+            for (const std::string& c : words)
+            {
+                ASSERT_LE(
+                    damerauLevenshteinDistance(a, c),
+                    ab + damerauLevenshteinDistance(b, c)) << a << " " << b << " " << c;
+            }
+        }
+    }
+}
+
+
+TEST(BKTree_Tests, emptyTreeHasNoSuggestions)
+{
+    BKTree tree;
+
+    EXPECT_EQ(0u, tree.size());
+    EXPECT_EQ(0u, tree.height());
+    EXPECT_EQ(SuggestionIndex::UNBOUNDED, tree.maxDistance());
+    EXPECT_TRUE(tree.suggestions("CAT", 2).empty());
+}
+
+
+TEST(BKTree_Tests, duplicateWordsAreAddedOnce)
+{
+    BKTree tree;
+    tree.add("CAT");
+    tree.add("BAT");
+    tree.add("CAT");
+    tree.add("BAT");
+
+    EXPECT_EQ(2u, tree.size());
+    EXPECT_EQ(2u, tree.height());
+}
+
+
+TEST(BKTree_Tests, suggestionsAreNearestFirstThenAlphabetical)
+{
+    BKTree tree;
+    for (const char* word : {"CAT", "BAT", "CART", "ACT", "CA T", "COAT", "DOG", "BOAT", "CATTLE", "AT"})
+        tree.add(word);
+
+    std::vector<std::string> expected{"ACT", "AT", "BAT", "CA T", "CART", "COAT", "BOAT"};
+    EXPECT_EQ(expected, tree.suggestions("CAT", 2));
+
+    expected = {"ACT", "AT", "BAT", "CA T", "CART", "COAT"};
+    EXPECT_EQ(expected, tree.suggestions("CAT", 1));
+
+    EXPECT_TRUE(tree.suggestions("CAT", 0).empty());
+}
+
+
+TEST(BKTree_Tests, wordsCloserByDamerauLevenshteinAreCheckedByEditDistance)
+{
+    BKTree tree;
+    tree.add("ABC");
+
+    EXPECT_TRUE(tree.suggestions("CA", 2).empty());
+
+    std::vector<std::string> expected{"ABC"};
+    EXPECT_EQ(expected, tree.suggestions("CA", 3));
+}
+
+
+TEST(BKTree_Tests, agreesWithMeasuringEveryWord)
+{
+    std::vector<std::string> dictionary = randomWords(1000, 5);
+
+    BKTree tree;
+    DeletionIndex index;
+
+    for (const std::string& word : dictionary)
+    {
+        tree.add(word);
+        index.add(word);
+    }
+
+    for (const std::string& word : randomWords(100, 6))
+    {
+        for (unsigned int distance = 0; distance <= 3; distance++)
+        {
+            std::vector<std::string> expected = TestWords::wordsWithin(dictionary, word, distance);
+            EXPECT_EQ(expected, tree.suggestions(word, distance)) << word;
+
+            if (distance <= index.maxDistance())
+            {
+                EXPECT_EQ(expected, index.suggestions(word, distance)) << word;
+            }
+        }
+    }
+}
+
+
+TEST(BKTree_Tests, searchesRuleOutMostOfTheTreeAtSmallDistances)
+{
+    std::mt19937 engine{7};
+    std::uniform_int_distribution<int> letters{'A', 'Z'};
+
+    BKTree tree;
+    for (unsigned int i = 0; i < 5000; i++)
+    {
+        std::string word(10, ' ');
+        for (char& c : word)
+            c = static_cast<char>(letters(engine));
+        tree.add(word);
+    }
+
+    unsigned int measured;
+    tree.suggestions("SPELLCHECK", 1, measured);
+
+    EXPECT_LT(measured, tree.size() / 2);
+}
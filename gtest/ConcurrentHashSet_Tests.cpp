@@ -0,0 +1,247 @@
+// ConcurrentHashSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the ConcurrentHashSet.
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentHashSet.hpp"
+#include "StringHash.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+
+
+    // A Point can be compared for equality, but has no ordering, which is
+    // all that a hash set should need.
+    struct Point
+    {
+        int x;
+        int y;
+
+        bool operator==(const Point& other) const noexcept
+        {
+            return x == other.x && y == other.y;
+        }
+    };
+
+
+    unsigned int pointHash(const Point& p)
+    {
+        return static_cast<unsigned int>(p.x * 31 + p.y);
+    }
+}
+
+
+TEST(ConcurrentHashSet_Tests, behavesLikeASetOnOneThread)
+{
+    ConcurrentHashSet<int> s{identityHash};
+
+    EXPECT_TRUE(s.isImplemented());
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+        s.add(i);
+    }
+
+    EXPECT_EQ(500, s.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentHashSet_Tests, elementsOnlyNeedToBeEqualityComparable)
+{
+    ConcurrentHashSet<Point> s{pointHash};
+    s.add(Point{1, 2});
+    s.add(Point{2, 1});
+    s.add(Point{1, 2});
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(Point{1, 2}));
+    EXPECT_TRUE(s.contains(Point{2, 1}));
+    EXPECT_FALSE(s.contains(Point{0, 33}));
+}
+
+
+TEST(ConcurrentHashSet_Tests, shardCountIsRoundedUpToAPowerOfTwo)
+{
+    ConcurrentHashSet<int> defaulted{identityHash};
+    ConcurrentHashSet<int> one{identityHash, 1};
+    ConcurrentHashSet<int> five{identityHash, 5};
+
+    EXPECT_EQ(ConcurrentHashSet<int>::DEFAULT_SHARD_COUNT, defaulted.shardCount());
+    EXPECT_EQ(1, one.shardCount());
+    EXPECT_EQ(8, five.shardCount());
+}
+
+
+TEST(ConcurrentHashSet_Tests, shardStatsAddUpToTheSize)
+{
+    // Even though an identity hash's high bits are all zero for small
+    // numbers, the elements should be spread across all of the shards.
+    ConcurrentHashSet<int> s{identityHash, 8};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+    }
+
+    unsigned int total = 0;
+
+    for (unsigned int shard = 0; shard < s.shardCount(); ++shard)
+    {
+        EXPECT_GT(s.elementsInShard(shard), 1000);
+        EXPECT_LE(s.elementsInShard(shard), s.capacityOfShard(shard) * 0.8);
+        total += s.elementsInShard(shard);
+    }
+
+    EXPECT_EQ(10000, total);
+    EXPECT_EQ(10000, s.size());
+    EXPECT_EQ(0, s.elementsInShard(8));
+    EXPECT_EQ(0, s.capacityOfShard(8));
+}
+
+
+TEST(ConcurrentHashSet_Tests, bucketStatsCountWhatHashedToEachIndex)
+{
+    ConcurrentHashSet<int> s{identityHash, 1};
+    s.add(0);
+    s.add(16);
+    s.add(32);
+    s.add(7);
+
+    EXPECT_EQ(3, s.elementsAtIndex(0, 0));
+    EXPECT_EQ(0, s.elementsAtIndex(0, 1));
+    EXPECT_EQ(1, s.elementsAtIndex(0, 7));
+    EXPECT_EQ(0, s.elementsAtIndex(0, s.capacityOfShard(0)));
+    EXPECT_EQ(0, s.elementsAtIndex(1, 0));
+
+    EXPECT_TRUE(s.isElementAtIndex(16, 0, 0));
+    EXPECT_FALSE(s.isElementAtIndex(16, 0, 1));
+    EXPECT_FALSE(s.isElementAtIndex(48, 0, 0));
+    EXPECT_FALSE(s.isElementAtIndex(16, 1, 0));
+}
+
+
+TEST(ConcurrentHashSet_Tests, bucketStatsAddUpToEachShard)
+{
+    ConcurrentHashSet<int> s{identityHash, 8};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+    }
+
+    for (unsigned int shard = 0; shard < s.shardCount(); ++shard)
+    {
+        unsigned int total = 0;
+
+        for (unsigned int index = 0; index < s.capacityOfShard(shard); ++index)
+        {
+            total += s.elementsAtIndex(shard, index);
+        }
+
+        EXPECT_EQ(s.elementsInShard(shard), total);
+    }
+}
+
+
+TEST(ConcurrentHashSet_Tests, canLookUpStringViewsWithoutBuildingStrings)
+{
+    ConcurrentHashSet<std::string, StringHash> s{StringHash{}};
+    s.add("HELLO");
+    s.add("THERE");
+
+    std::string_view text{"HELLOTHERE"};
+
+    EXPECT_TRUE(s.contains(text.substr(0, 5)));
+    EXPECT_TRUE(s.contains(text.data() + 5, 5));
+    EXPECT_FALSE(s.contains(text));
+    EXPECT_TRUE(s.contains("HELLO"));
+}
+
+
+TEST(ConcurrentHashSet_Tests, concurrentAddsAreAllKept)
+{
+    // Each writer adds its own share of the elements, plus a range of
+    // elements that every writer adds, while readers keep checking that
+    // nothing they've seen goes away.
+    constexpr int writerCount = 4;
+    constexpr int readerCount = 2;
+    constexpr int count = 20000;
+
+    ConcurrentHashSet<int> s{identityHash, 4};
+    std::atomic<bool> done{false};
+    std::atomic<bool> lost{false};
+
+    std::vector<std::thread> threads;
+
+    for (int writer = 0; writer < writerCount; ++writer)
+    {
+        threads.emplace_back(
+            [&s, writer]()
+            {
+                for (int i = writer; i < count; i += writerCount)
+                {
+                    s.add(i);
+                    s.add(count + i % 100);
+                }
+            });
+    }
+
+    for (int reader = 0; reader < readerCount; ++reader)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                while (!done.load())
+                {
+                    for (int i = 0; i < count; i += 7)
+                    {
+                        if (s.contains(i) && !s.contains(i))
+                        {
+                            lost.store(true);
+                        }
+                    }
+                }
+            });
+    }
+
+    for (int writer = 0; writer < writerCount; ++writer)
+    {
+        threads[writer].join();
+    }
+
+    done.store(true);
+
+    for (int reader = writerCount; reader < writerCount + readerCount; ++reader)
+    {
+        threads[reader].join();
+    }
+
+    EXPECT_FALSE(lost.load());
+    EXPECT_EQ(count + 100, s.size());
+
+    for (int i = 0; i < count + 100; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+
+    EXPECT_FALSE(s.contains(count + 100));
+}
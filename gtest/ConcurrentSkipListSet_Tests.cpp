@@ -0,0 +1,158 @@
+// ConcurrentSkipListSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the ConcurrentSkipListSet.
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentSkipListSet.hpp"
+
+
+namespace
+{
+    template <typename ElementType>
+    class NeverGrowLevelTester : public SkipListLevelTester<ElementType>
+    {
+    public:
+        bool shouldOccupyNextLevel(const ElementType& /* element */) override
+        {
+            return false;
+        }
+
+        std::unique_ptr<SkipListLevelTester<ElementType>> clone() override
+        {
+            return std::make_unique<NeverGrowLevelTester>();
+        }
+    };
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, behavesLikeASetOnOneThread)
+{
+    ConcurrentSkipListSet<int> s;
+
+    EXPECT_TRUE(s.isImplemented());
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+        s.add(i);
+    }
+
+    EXPECT_EQ(500, s.size());
+    EXPECT_EQ(500, s.elementsOnLevel(0));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, honorsTheLevelTester)
+{
+    ConcurrentSkipListSet<int> s{std::make_unique<NeverGrowLevelTester<int>>()};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(1, s.levelCount());
+    EXPECT_EQ(100, s.elementsOnLevel(0));
+    EXPECT_EQ(0, s.elementsOnLevel(1));
+    EXPECT_TRUE(s.isElementOnLevel(50, 0));
+    EXPECT_FALSE(s.isElementOnLevel(50, 1));
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, canLookUpStringViewsWithoutBuildingStrings)
+{
+    ConcurrentSkipListSet<std::string> s;
+    s.add("HELLO");
+    s.add("THERE");
+
+    std::string_view text{"HELLOTHERE"};
+
+    EXPECT_TRUE(s.contains(text.substr(0, 5)));
+    EXPECT_TRUE(s.contains(text.data() + 5, 5));
+    EXPECT_FALSE(s.contains(text));
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, concurrentAddsAreAllKept)
+{
+    // Each writer adds every element whose value mod the number of writers
+    // is its own number, plus a range of elements that all of the writers
+    // add, while readers keep checking that nothing they've seen goes away.
+    constexpr int writerCount = 4;
+    constexpr int readerCount = 2;
+    constexpr int count = 4000;
+
+    ConcurrentSkipListSet<int> s;
+    std::atomic<bool> done{false};
+    std::atomic<bool> lost{false};
+
+    std::vector<std::thread> threads;
+
+    for (int writer = 0; writer < writerCount; ++writer)
+    {
+        threads.emplace_back(
+            [&s, writer]()
+            {
+                for (int i = writer; i < count; i += writerCount)
+                {
+                    s.add(i);
+                    s.add(count + i % 100);
+                }
+            });
+    }
+
+    for (int reader = 0; reader < readerCount; ++reader)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                while (!done.load())
+                {
+                    for (int i = 0; i < count; ++i)
+                    {
+                        if (s.contains(i) && !s.contains(i))
+                        {
+                            lost.store(true);
+                        }
+                    }
+                }
+            });
+    }
+
+    for (int writer = 0; writer < writerCount; ++writer)
+    {
+        threads[writer].join();
+    }
+
+    done.store(true);
+
+    for (int reader = writerCount; reader < writerCount + readerCount; ++reader)
+    {
+        threads[reader].join();
+    }
+
+    EXPECT_FALSE(lost.load());
+    EXPECT_EQ(count + 100, s.size());
+    EXPECT_EQ(count + 100, s.elementsOnLevel(0));
+
+    for (int i = 0; i < count + 100; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+
+    EXPECT_FALSE(s.contains(count + 100));
+}
@@ -0,0 +1,370 @@
+// DAWGSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for DAWGSet.
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DAWGSet.hpp"
+#include "HashSet.hpp"
+#include "Set.hpp"
+#include "StringHash.hpp"
+#include "TestWords.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> randomWords(unsigned int count, unsigned int seed)
+    {
+        return TestWords::randomWords(count, seed, 0, 6, 'A', 'D');
+    }
+
+
+    // expectSameAs() checks that the DAWGSet contains exactly the words in
+    // expected, by asking about every word that randomWords() can make.
+    void expectSameAs(const std::set<std::string>& expected, const DAWGSet& s)
+    {
+        EXPECT_EQ(expected.size(), s.size());
+
+        for (const std::string& word : randomWords(3000, 99))
+            EXPECT_EQ(expected.count(word) == 1, s.contains(word)) << word;
+
+        for (const std::string& word : expected)
+            EXPECT_TRUE(s.contains(word)) << word;
+    }
+}
+
+
+TEST(DAWGSet_Tests, emptySetContainsNothing)
+{
+    DAWGSet s;
+
+    EXPECT_EQ(0u, s.size());
+    EXPECT_FALSE(s.contains(""));
+    EXPECT_FALSE(s.contains("A"));
+}
+
+
+TEST(DAWGSet_Tests, canBeUsedAsASet)
+{
+    DAWGSet d;
+    Set<std::string>& s = d;
+
+    s.add("CAT");
+    s.add("CATS");
+    s.add("DOG");
+
+    EXPECT_TRUE(s.isImplemented());
+    EXPECT_EQ(3u, s.size());
+    EXPECT_TRUE(s.contains("CAT"));
+    EXPECT_TRUE(s.contains("CATS"));
+    EXPECT_TRUE(s.contains("DOG"));
+    EXPECT_FALSE(s.contains("CA"));
+    EXPECT_FALSE(s.contains("CATSS"));
+    EXPECT_FALSE(s.contains("DO"));
+    EXPECT_FALSE(s.contains(""));
+}
+
+
+TEST(DAWGSet_Tests, containsTheEmptyStringOnlyOnceAdded)
+{
+    DAWGSet s;
+    s.add("");
+    s.add("A");
+
+    EXPECT_TRUE(s.contains(""));
+    EXPECT_TRUE(s.contains("A"));
+    EXPECT_EQ(2u, s.size());
+}
+
+
+TEST(DAWGSet_Tests, duplicatesAreAddedOnce)
+{
+    DAWGSet s;
+    s.add("BAT");
+    s.add("BAT");
+    s.add("CAT");
+    s.add("BAT");
+
+    EXPECT_EQ(2u, s.size());
+    EXPECT_TRUE(s.contains("BAT"));
+    EXPECT_TRUE(s.contains("CAT"));
+}
+
+
+TEST(DAWGSet_Tests, canLookUpStringViewsAndCharacters)
+{
+    DAWGSet s;
+    s.add("CAT");
+
+    std::string text = "CATS";
+
+    EXPECT_TRUE(s.contains(std::string_view{text}.substr(0, 3)));
+    EXPECT_FALSE(s.contains(std::string_view{text}));
+    EXPECT_TRUE(s.contains(text.data(), 3));
+    EXPECT_FALSE(s.contains(text.data(), 2));
+}
+
+
+TEST(DAWGSet_Tests, sharedSuffixesShareStates)
+{
+    DAWGSet s;
+    for (const char* word : {"BATS", "CATS", "HATS", "MATS", "RATS"})
+        s.add(word);
+
+    // Until the graph is compacted, the states along "RATS" are separate.
+    EXPECT_EQ(8u, s.stateCount());
+    EXPECT_EQ(11u, s.transitionCount());
+
+    // The root, one state after each first letter (all of which are the
+    // same), then one after "A", one after "T", and one after "S".
+    s.compact();
+
+    EXPECT_EQ(5u, s.stateCount());
+    EXPECT_EQ(8u, s.transitionCount());
+    EXPECT_TRUE(s.contains("RATS"));
+    EXPECT_FALSE(s.contains("RAT"));
+}
+
+
+TEST(DAWGSet_Tests, sortedAddsMatchAStdSet)
+{
+    std::vector<std::string> words = randomWords(500, 1);
+    std::set<std::string> expected{words.begin(), words.end()};
+
+    DAWGSet s;
+    for (const std::string& word : expected)
+        s.add(word);
+
+    expectSameAs(expected, s);
+}
+
+
+TEST(DAWGSet_Tests, outOfOrderAddsMatchAStdSet)
+{
+    std::vector<std::string> words = randomWords(300, 2);
+    std::set<std::string> expected;
+
+    DAWGSet s;
+    for (const std::string& word : words)
+    {
+        s.add(word);
+        expected.insert(word);
+    }
+
+    expectSameAs(expected, s);
+}
+
+
+TEST(DAWGSet_Tests, constructingFromUnsortedWordsMatchesAStdSet)
+{
+    std::vector<std::string> words = randomWords(2000, 3);
+    std::set<std::string> expected{words.begin(), words.end()};
+
+    DAWGSet s{words};
+
+    expectSameAs(expected, s);
+}
+
+
+TEST(DAWGSet_Tests, graphIsTheSameHoweverItWasBuilt)
+{
+    std::vector<std::string> words = randomWords(1000, 4);
+
+    DAWGSet sorted{words};
+    DAWGSet added;
+    for (const std::string& word : words)
+        added.add(word);
+
+    EXPECT_EQ(sorted.stateCount(), added.stateCount());
+    EXPECT_EQ(sorted.transitionCount(), added.transitionCount());
+}
+
+
+TEST(DAWGSet_Tests, canAddWordsAfterCompacting)
+{
+    std::vector<std::string> words = randomWords(2000, 5);
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::vector<std::string> firstHalf{words.begin(), words.begin() + words.size() / 2};
+    std::vector<std::string> secondHalf{words.begin() + words.size() / 2, words.end()};
+
+    DAWGSet s{firstHalf};
+    std::size_t before = s.memoryUsage();
+
+    s.compact();
+    EXPECT_LT(s.memoryUsage(), before);
+
+    for (const std::string& word : secondHalf)
+        s.add(word);
+
+    expectSameAs(std::set<std::string>{words.begin(), words.end()}, s);
+
+    // Only the copies of the states along the last word before compacting
+    // can be left behind.
+    DAWGSet reference{words};
+    reference.compact();
+    s.compact();
+
+    EXPECT_LE(reference.stateCount(), s.stateCount());
+    EXPECT_GE(reference.stateCount() + 7, s.stateCount());
+}
+
+
+TEST(DAWGSet_Tests, copiesAreIndependent)
+{
+    DAWGSet s;
+    s.add("BAT");
+    s.add("CAT");
+
+    DAWGSet copy{s};
+    copy.add("DOG");
+    s.add("EEL");
+
+    EXPECT_TRUE(copy.contains("DOG"));
+    EXPECT_FALSE(copy.contains("EEL"));
+    EXPECT_TRUE(s.contains("EEL"));
+    EXPECT_FALSE(s.contains("DOG"));
+}
+
+
+TEST(DAWGSet_Tests, usesLessMemoryThanCharactersForSharedAffixes)
+{
+    const char* stems[] = {"WALK", "TALK", "JUMP", "PLAY", "WORK", "LOOK", "CALL", "HELP"};
+    const char* suffixes[] = {"", "S", "ED", "ING", "ER", "ERS"};
+
+    std::vector<std::string> words;
+    std::size_t characters = 0;
+    for (const char* stem : stems)
+    {
+        for (const char* suffix : suffixes)
+        {
+            words.push_back(std::string{stem} + suffix);
+            characters += words.back().size();
+        }
+    }
+
+    DAWGSet s{words};
+
+    EXPECT_EQ(words.size(), s.size());
+    EXPECT_LT(s.transitionCount() * 4, characters);
+}
+
+
+TEST(DAWGSet_Tests, worksWithAWordChecker)
+{
+    const char* dictionary[] = {
+        "BAT", "CART", "CAT", "CA T", "CAST", "AT", "ACTS", "A", "XA", "AAX", "AXA", "AAA"};
+
+    HashSet<std::string, StringHash> hashSet{StringHash{}};
+    DAWGSet dawg;
+
+    for (const char* word : dictionary)
+    {
+        hashSet.add(word);
+        dawg.add(word);
+    }
+
+    WordChecker reference{hashSet};
+    WordChecker checker{dawg};
+
+    for (const char* word : {"CAAT", "CAT ", "ACT", "AX", "AAAA", "CAT"})
+    {
+        EXPECT_EQ(reference.wordExists(word), checker.wordExists(word));
+        EXPECT_EQ(reference.findSuggestions(word), checker.findSuggestions(word));
+    }
+}
+
+
+TEST(DAWGSet_Tests, canBeSearchedACharacterAtATime)
+{
+    DAWGSet s;
+    for (const char* word : {"CAR", "CART", "CAT", "DOG"})
+        s.add(word);
+
+    for (bool compacted : {false, true})
+    {
+        if (compacted)
+            s.compact();
+
+        DAWGSet::Position position = s.root();
+        EXPECT_FALSE(position.final);
+
+        std::string labels;
+        s.forEachTransition(position, [&](char c, DAWGSet::Position) { labels += c; });
+        EXPECT_EQ("CD", labels);
+
+        EXPECT_FALSE(s.advance(position, 'B'));
+        ASSERT_TRUE(s.advance(position, 'C'));
+        ASSERT_TRUE(s.advance(position, 'A'));
+
+        labels.clear();
+        s.forEachTransition(
+            position,
+            [&](char c, DAWGSet::Position next)
+            {
+                labels += c;
+                EXPECT_TRUE(next.final);
+            });
+        EXPECT_EQ("RT", labels);
+
+        EXPECT_TRUE(s.containsFrom(position, "RT", 2));
+        EXPECT_TRUE(s.containsFrom(position, "T", 1));
+        EXPECT_FALSE(s.containsFrom(position, "", 0));
+        EXPECT_FALSE(s.containsFrom(position, "TS", 2));
+    }
+}
+
+
+TEST(DAWGSet_Tests, suggestionsMatchProbingInTheSameOrder)
+{
+    std::default_random_engine engine{8};
+    std::uniform_int_distribution<unsigned int> lengths{1, 12};
+    std::uniform_int_distribution<int> letters{'A', 'F'};
+
+    auto randomWord = [&]()
+    {
+        std::string word(lengths(engine), ' ');
+        for (char& c : word)
+            c = static_cast<char>(letters(engine));
+        return word;
+    };
+
+    HashSet<std::string, StringHash> hashSet{StringHash{}};
+    std::vector<std::string> words;
+
+    for (unsigned int i = 0; i < 3000; i++)
+    {
+        std::string word = randomWord();
+
+        // A few words with spaces in them, so that splits are found, too.
+        if (i % 10 == 0 && word.size() > 2)
+            word[word.size() / 2] = ' ';
+
+        words.push_back(word);
+        hashSet.add(word);
+    }
+
+    DAWGSet dawg{words};
+
+    WordChecker reference{hashSet};
+    WordChecker guided{dawg};
+
+    for (unsigned int i = 0; i < 300; i++)
+    {
+        std::string word = i % 2 == 0 ? randomWord() : words[i];
+        if (i % 3 == 0 && !word.empty())
+            word.pop_back();
+
+        EXPECT_EQ(reference.findSuggestions(word), guided.findSuggestions(word)) << word;
+    }
+}
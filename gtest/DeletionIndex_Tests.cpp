@@ -0,0 +1,240 @@
+// DeletionIndex_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for DeletionIndex, and for the editDistance() function that
+// it checks its suggestions with.
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DeletionIndex.hpp"
+#include "EditDistance.hpp"
+#include "HashSet.hpp"
+#include "StringHash.hpp"
+#include "TestWords.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> randomWords(unsigned int count, unsigned int seed)
+    {
+        return TestWords::randomWords(count, seed, 1, 7, 'A', 'E');
+    }
+}
+
+
+TEST(DeletionIndex_Tests, editDistanceCountsEachKindOfEdit)
+{
+    EXPECT_EQ(0u, editDistance("CAT", "CAT"));
+    EXPECT_EQ(1u, editDistance("CAT", "CART"));
+    EXPECT_EQ(1u, editDistance("CART", "CAT"));
+    EXPECT_EQ(1u, editDistance("CAT", "BAT"));
+    EXPECT_EQ(1u, editDistance("CAT", "ACT"));
+    EXPECT_EQ(1u, editDistance("CAT", "CA T"));
+    EXPECT_EQ(2u, editDistance("CAT", "TAC"));
+    EXPECT_EQ(3u, editDistance("", "CAT"));
+    EXPECT_EQ(3u, editDistance("KITTEN", "SITTING"));
+}
+
+
+TEST(DeletionIndex_Tests, editDistanceDoesNotEditSwappedCharactersAgain)
+{
+    // Turning "CA" into "ABC" takes a swap and then an insertion between
+    // the swapped characters, which optimal string alignment doesn't allow.
+    EXPECT_EQ(3u, editDistance("CA", "ABC"));
+}
+
+
+TEST(DeletionIndex_Tests, editDistanceStopsPastTheLimit)
+{
+    EXPECT_EQ(2u, editDistance("KITTEN", "SITTING", 1));
+    EXPECT_EQ(3u, editDistance("ABCDEFGH", "ZZZZZZZZ", 2));
+    EXPECT_EQ(2u, editDistance("A", "ABCDEF", 1));
+    EXPECT_EQ(1u, editDistance("CAT", "ACT", 1));
+}
+
+
+TEST(DeletionIndex_Tests, editDistanceWithALimitAgreesWithoutOne)
+{
+    std::vector<std::string> words = randomWords(150, 46);
+
+    for (const std::string& a : words)
+    {
+        for (const std::string& b : words)
+        {
+            unsigned int full = editDistance(a, b);
+
+            for (unsigned int limit = 0; limit <= 3; limit++)
+                ASSERT_EQ(std::min(full, limit + 1), editDistance(a, b, limit)) << a << " " << b;
+        }
+    }
+}
+
+
+TEST(DeletionIndex_Tests, duplicateWordsAreIndexedOnce)
+{
+    DeletionIndex index;
+    index.add("CAT");
+    unsigned int deletions = index.deletionCount();
+
+    index.add("CAT");
+
+    EXPECT_EQ(1u, index.size());
+    EXPECT_EQ(deletions, index.deletionCount());
+
+    // "CAT", then "AT", "CT", and "CA", then "T", "A", and "C"
+    EXPECT_EQ(7u, deletions);
+}
+
+
+TEST(DeletionIndex_Tests, suggestionsAreNearestFirstThenAlphabetical)
+{
+    DeletionIndex index;
+    for (const char* word : {"CAT", "BAT", "CART", "ACT", "CA T", "COAT", "DOG", "BOAT", "CATTLE", "AT"})
+        index.add(word);
+
+    std::vector<std::string> expected{"ACT", "AT", "BAT", "CA T", "CART", "COAT", "BOAT"};
+    EXPECT_EQ(expected, index.suggestions("CAT", 2));
+
+    expected = {"ACT", "AT", "BAT", "CA T", "CART", "COAT"};
+    EXPECT_EQ(expected, index.suggestions("CAT", 1));
+
+    EXPECT_TRUE(index.suggestions("CAT", 0).empty());
+    EXPECT_TRUE(index.suggestions("ZZZZZZ", 2).empty());
+}
+
+
+TEST(DeletionIndex_Tests, wordsSharingADeletionButFarApartAreNotSuggested)
+{
+    DeletionIndex index;
+    index.add("CDAB");
+
+    EXPECT_TRUE(index.suggestions("ABCD", 2).empty());
+}
+
+
+TEST(DeletionIndex_Tests, largerDistancesThanTheIndexSupportsAreCapped)
+{
+    DeletionIndex index{1};
+    index.add("CAT");
+    index.add("COASTS");
+
+    std::vector<std::string> expected{"CAT"};
+    EXPECT_EQ(expected, index.suggestions("CAST", 3));
+}
+
+
+TEST(DeletionIndex_Tests, wordCheckersLookPastTheIndexForLargerDistances)
+{
+    HashSet<std::string, StringHash> set{StringHash{}};
+    DeletionIndex index{1};
+
+    for (const char* word : {"CAT", "COST", "COASTS"})
+    {
+        set.add(word);
+        index.add(word);
+    }
+
+    EXPECT_EQ(1u, index.maxDistance());
+
+    WordChecker checker{set, index};
+
+    std::vector<std::string> expected{"CAT", "COST"};
+    EXPECT_EQ(expected, checker.findSuggestionsWithin("CAST", 1));
+
+    expected = {"CAT", "COST", "COASTS"};
+    EXPECT_EQ(expected, checker.findSuggestionsWithin("CAST", 2));
+}
+
+
+TEST(DeletionIndex_Tests, wordsAddedAfterSearchingAreFound)
+{
+    DeletionIndex index;
+    index.add("CAT");
+
+    std::vector<std::string> expected{"CAT"};
+    EXPECT_EQ(expected, index.suggestions("CAST", 2));
+
+    index.add("COST");
+
+    expected = {"CAT", "COST"};
+    EXPECT_EQ(expected, index.suggestions("CAST", 2));
+}
+
+
+TEST(DeletionIndex_Tests, agreesWithApplyingTheFiveStrategiesTwice)
+{
+    std::vector<std::string> dictionary = randomWords(400, 1);
+
+    HashSet<std::string, StringHash> set{StringHash{}};
+    DeletionIndex index;
+
+    for (const std::string& word : dictionary)
+    {
+        set.add(word);
+        index.add(word);
+    }
+
+    WordChecker probing{set};
+    WordChecker indexed{set, index};
+
+    for (const std::string& word : randomWords(40, 2))
+    {
+        for (unsigned int distance = 0; distance <= 2; distance++)
+        {
+            EXPECT_EQ(
+                probing.findSuggestionsWithin(word, distance),
+                indexed.findSuggestionsWithin(word, distance)) << word;
+        }
+    }
+}
+
+
+TEST(DeletionIndex_Tests, canBeSearchedFromManyThreadsAtOnce)
+{
+    std::vector<std::string> dictionary = randomWords(2000, 3);
+    std::vector<std::string> queries = randomWords(200, 4);
+
+    DeletionIndex index;
+    for (const std::string& word : dictionary)
+        index.add(word);
+
+    std::vector<std::vector<std::string>> expected;
+    {
+        DeletionIndex reference;
+        for (const std::string& word : dictionary)
+            reference.add(word);
+
+        for (const std::string& query : queries)
+            expected.push_back(reference.suggestions(query, 2));
+    }
+
+    // Nothing has searched this index yet, so the threads race to sort it.
+    std::vector<std::thread> threads;
+    std::vector<char> matched(4, true);
+
+    for (unsigned int t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (std::size_t q = 0; q < queries.size(); q++)
+                {
+                    if (index.suggestions(queries[q], 2) != expected[q])
+                        matched[t] = false;
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (unsigned int t = 0; t < 4; t++)
+        EXPECT_TRUE(matched[t]);
+}
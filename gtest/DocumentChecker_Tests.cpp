@@ -0,0 +1,172 @@
+// DocumentChecker_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the DocumentChecker.
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DocumentChecker.hpp"
+#include "HashSet.hpp"
+#include "Set.hpp"
+#include "StringHash.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // A CountingSet wraps another set, counting how many times it's been
+    // asked whether it contains each of a few words.
+    class CountingSet : public Set<std::string>
+    {
+    public:
+        explicit CountingSet(const Set<std::string>& words)
+            : words{words}
+        {
+        }
+
+        bool isImplemented() const noexcept override
+        {
+            return true;
+        }
+
+        void add(const std::string& /* element */) override
+        {
+        }
+
+        bool contains(const std::string& element) const override
+        {
+            if (element == "CAT")
+            {
+                catLookups.fetch_add(1);
+            }
+            else if (element == "DOGG")
+            {
+                doggLookups.fetch_add(1);
+            }
+
+            return words.contains(element);
+        }
+
+        unsigned int size() const noexcept override
+        {
+            return words.size();
+        }
+
+        mutable std::atomic<int> catLookups{0};
+        mutable std::atomic<int> doggLookups{0};
+
+    private:
+        const Set<std::string>& words;
+    };
+
+
+    HashSet<std::string, StringHash> dictionary()
+    {
+        HashSet<std::string, StringHash> words{StringHash{}};
+
+        for (const char* word : {"THE", "CAT", "SAT", "ON", "A", "MAT", "DOG", "DIG"})
+        {
+            words.add(word);
+        }
+
+        return words;
+    }
+}
+
+
+TEST(DocumentChecker_Tests, reportsEveryWordInDocumentOrder)
+{
+    HashSet<std::string, StringHash> words = dictionary();
+    WordChecker checker{words};
+    DocumentChecker documents{checker, 2};
+
+    std::string document = "The cat sat on a mta -- dgo!";
+    std::vector<DocumentChecker::WordResult> results = documents.check(document);
+
+    ASSERT_EQ(7, results.size());
+
+    std::vector<std::string> expectedWords{"THE", "CAT", "SAT", "ON", "A", "MTA", "DGO"};
+
+    for (unsigned int i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(expectedWords[i], results[i].word);
+        EXPECT_EQ(i < 5, results[i].exists);
+        EXPECT_EQ(results[i].word.size(), results[i].length);
+    }
+
+    EXPECT_EQ(0, results[0].offset);
+    EXPECT_EQ(4, results[1].offset);
+    EXPECT_EQ(17, results[5].offset);
+    EXPECT_EQ(24, results[6].offset);
+
+    EXPECT_TRUE(results[0].suggestions.empty());
+    EXPECT_EQ(checker.findSuggestions("MTA"), results[5].suggestions);
+    EXPECT_EQ(checker.findSuggestions("DGO"), results[6].suggestions);
+    EXPECT_FALSE(results[6].suggestions.empty());
+}
+
+
+TEST(DocumentChecker_Tests, checksEachDistinctWordOnce)
+{
+    HashSet<std::string, StringHash> words = dictionary();
+    CountingSet counting{words};
+    WordChecker checker{counting};
+    DocumentChecker documents{checker, 3};
+
+    std::vector<std::string> batch{
+        "cat CAT Cat dogg",
+        "",
+        "dogg, cat; dogg."};
+
+    std::vector<std::vector<DocumentChecker::WordResult>> results = documents.checkAll(batch);
+
+    ASSERT_EQ(3, results.size());
+    EXPECT_EQ(4, results[0].size());
+    EXPECT_TRUE(results[1].empty());
+    EXPECT_EQ(3, results[2].size());
+
+    // "CAT" is looked up once to see that it's spelled correctly.  "DOGG"
+    // is looked up once for that, then twice by findSuggestions(): once
+    // to check it again, and once more as the candidate made by swapping
+    // its last two letters.
+    EXPECT_EQ(1, counting.catLookups.load());
+    EXPECT_EQ(3, counting.doggLookups.load());
+
+    std::vector<std::string> expected{"DOG"};
+    EXPECT_EQ(expected, results[2][0].suggestions);
+    EXPECT_EQ(expected, results[2][2].suggestions);
+    EXPECT_TRUE(results[2][1].exists);
+}
+
+
+TEST(DocumentChecker_Tests, manyThreadsGiveTheSameResultsAsOne)
+{
+    HashSet<std::string, StringHash> words = dictionary();
+    WordChecker checker{words};
+    DocumentChecker single{checker, 1};
+    DocumentChecker multiple{checker, 4};
+
+    std::string document;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        document += "the cat sat on a mta " + std::string(1 + i % 5, 'A' + i % 26) + " ";
+    }
+
+    std::vector<DocumentChecker::WordResult> expected = single.check(document);
+    std::vector<DocumentChecker::WordResult> results = multiple.check(document);
+
+    ASSERT_EQ(expected.size(), results.size());
+
+    for (unsigned int i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(expected[i].offset, results[i].offset);
+        EXPECT_EQ(expected[i].word, results[i].word);
+        EXPECT_EQ(expected[i].exists, results[i].exists);
+        EXPECT_EQ(expected[i].suggestions, results[i].suggestions);
+    }
+}
@@ -0,0 +1,158 @@
+// FrozenAVLSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the FrozenAVLSet that AVLSet::freeze() returns.
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "FrozenAVLSet.hpp"
+
+
+TEST(FrozenAVLSet_Tests, containsTheSameElementsAsTheAVLSet)
+{
+    // Every size from 0 to 70 covers trees whose bottom level is empty,
+    // partly filled, and full.
+    for (int n = 0; n <= 70; ++n)
+    {
+        AVLSet<int> s;
+
+        for (int i = 0; i < n; ++i)
+        {
+            s.add((i * 37) % n * 2);
+        }
+
+        FrozenAVLSet<int> frozen = s.freeze();
+
+        ASSERT_EQ(s.size(), frozen.size());
+
+        for (int i = -1; i <= 2 * n; ++i)
+        {
+            EXPECT_EQ(s.contains(i), frozen.contains(i));
+        }
+    }
+}
+
+
+TEST(FrozenAVLSet_Tests, inorderVisitsElementsInAscendingOrder)
+{
+    AVLSet<int> s;
+
+    for (int i : {50, 20, 80, 10, 30, 70, 90, 60, 40})
+    {
+        s.add(i);
+    }
+
+    std::vector<int> expected;
+    s.inorder([&](const int& element) { expected.push_back(element); });
+
+    std::vector<int> elements;
+    s.freeze().inorder([&](const int& element) { elements.push_back(element); });
+
+    EXPECT_EQ(expected, elements);
+}
+
+
+TEST(FrozenAVLSet_Tests, visitRangeVisitsOnlyElementsInTheRange)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 100; i += 5)
+    {
+        s.add(i);
+    }
+
+    FrozenAVLSet<int> frozen = s.freeze();
+
+    std::vector<int> elements;
+    frozen.visitRange(12, 40, [&](const int& element) { elements.push_back(element); });
+
+    std::vector<int> expected{15, 20, 25, 30, 35};
+    EXPECT_EQ(expected, elements);
+
+    elements.clear();
+    frozen.visitRange(200, 300, [&](const int& element) { elements.push_back(element); });
+
+    EXPECT_TRUE(elements.empty());
+}
+
+
+TEST(FrozenAVLSet_Tests, canLookUpStringViewsWithoutBuildingStrings)
+{
+    AVLSet<std::string> s;
+    s.add("HELLO");
+    s.add("THERE");
+    s.add("BOO");
+
+    FrozenAVLSet<std::string> frozen = s.freeze();
+
+    std::string_view text{"BOOHELLOTHERE"};
+
+    EXPECT_TRUE(frozen.contains(text.substr(0, 3)));
+    EXPECT_TRUE(frozen.contains(text.substr(3, 5)));
+    EXPECT_TRUE(frozen.contains(text.data() + 8, 5));
+    EXPECT_FALSE(frozen.contains(text));
+    EXPECT_FALSE(frozen.contains(text.data(), 2));
+    EXPECT_TRUE(frozen.contains("HELLO"));
+}
+
+
+TEST(FrozenAVLSet_Tests, addingHasNoEffect)
+{
+    AVLSet<int> s;
+    s.add(11);
+
+    FrozenAVLSet<int> frozen = s.freeze();
+    frozen.add(12);
+
+    EXPECT_EQ(1, frozen.size());
+    EXPECT_TRUE(frozen.contains(11));
+    EXPECT_FALSE(frozen.contains(12));
+}
+
+
+TEST(FrozenAVLSet_Tests, isIndependentOfTheAVLSet)
+{
+    AVLSet<int> s;
+    s.add(1);
+
+    FrozenAVLSet<int> frozen = s.freeze();
+    s.add(2);
+
+    EXPECT_EQ(1, frozen.size());
+    EXPECT_FALSE(frozen.contains(2));
+}
+
+
+TEST(FrozenAVLSet_Tests, canBeCopiedAndMoved)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+    }
+
+    FrozenAVLSet<int> frozen = s.freeze();
+    FrozenAVLSet<int> copy{frozen};
+
+    EXPECT_EQ(10, copy.size());
+    EXPECT_TRUE(copy.contains(9));
+
+    FrozenAVLSet<int> moved{std::move(frozen)};
+
+    EXPECT_EQ(10, moved.size());
+    EXPECT_TRUE(moved.contains(0));
+
+    FrozenAVLSet<int> empty;
+    empty = copy;
+
+    EXPECT_EQ(10, empty.size());
+    EXPECT_TRUE(empty.contains(5));
+    EXPECT_FALSE(empty.contains(10));
+}
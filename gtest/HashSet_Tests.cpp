@@ -0,0 +1,479 @@
+// HashSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the HashSet functionality beyond what the sanity-checking
+// tests cover, most notably the open-addressing layout.
+
+#include <cstddef>
+#include <string>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "StringHash.hpp"
+
+
+namespace
+{
+    template <typename T>
+    unsigned int zeroHash(const T& /* t */)
+    {
+        return 0;
+    }
+
+
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+
+
+    unsigned int lengthHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(s.size());
+    }
+
+
+    struct ModuloHash
+    {
+        unsigned int operator()(const int& i) const
+        {
+            return static_cast<unsigned int>(i) % 7;
+        }
+    };
+}
+
+
+TEST(HashSet_Tests, layoutIsChosenAtConstruction)
+{
+    HashSet<int> chained{zeroHash<int>};
+    HashSet<int> open{zeroHash<int>, HashSetLayout::OpenAddressing};
+
+    EXPECT_EQ(HashSetLayout::SeparateChaining, chained.layout());
+    EXPECT_EQ(HashSetLayout::OpenAddressing, open.layout());
+}
+
+
+TEST(HashSet_Tests, openAddressingContainsElementsAfterAdding)
+{
+    HashSet<int> s{zeroHash<int>, HashSetLayout::OpenAddressing};
+    s.add(11);
+    s.add(1);
+    s.add(5);
+    s.add(5);
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(11));
+    EXPECT_TRUE(s.contains(1));
+    EXPECT_TRUE(s.contains(5));
+    EXPECT_FALSE(s.contains(21));
+    EXPECT_FALSE(s.contains(2));
+}
+
+
+TEST(HashSet_Tests, openAddressingElementsAtIndexAccordingToHash)
+{
+    HashSet<int> s{zeroHash<int>, HashSetLayout::OpenAddressing};
+    s.add(11);
+    s.add(1);
+    s.add(5);
+
+    EXPECT_EQ(3, s.elementsAtIndex(0));
+    EXPECT_EQ(0, s.elementsAtIndex(1));
+    EXPECT_EQ(0, s.elementsAtIndex(10));
+
+    EXPECT_TRUE(s.isElementAtIndex(11, 0));
+    EXPECT_FALSE(s.isElementAtIndex(11, 1));
+    EXPECT_FALSE(s.isElementAtIndex(7, 0));
+}
+
+
+TEST(HashSet_Tests, bothLayoutsAgreeAfterResizing)
+{
+    HashSet<int> chained{identityHash};
+    HashSet<int> open{identityHash, HashSetLayout::OpenAddressing};
+
+    for (int i = 0; i < 1000; i += 3)
+    {
+        chained.add(i);
+        open.add(i);
+    }
+
+    ASSERT_EQ(chained.size(), open.size());
+
+    for (unsigned int index = 0; index < 2000; ++index)
+    {
+        EXPECT_EQ(chained.elementsAtIndex(index), open.elementsAtIndex(index));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 3 == 0, open.contains(i));
+        EXPECT_EQ(chained.contains(i), open.contains(i));
+    }
+}
+
+
+TEST(HashSet_Tests, collidingStringsSurviveResizing)
+{
+    HashSet<std::string> s{lengthHash, HashSetLayout::OpenAddressing};
+    std::string word;
+
+    for (char c = 'A'; c <= 'Z'; ++c)
+    {
+        s.add(word + c);
+        s.add(word + c + c);
+    }
+
+    EXPECT_EQ(52, s.size());
+    EXPECT_EQ(26, s.elementsAtIndex(1));
+    EXPECT_EQ(26, s.elementsAtIndex(2));
+    EXPECT_TRUE(s.contains("Q"));
+    EXPECT_TRUE(s.contains("QQ"));
+    EXPECT_FALSE(s.contains("QR"));
+}
+
+
+TEST(HashSet_Tests, copiesAndMovesKeepTheirLayout)
+{
+    HashSet<int> s{identityHash, HashSetLayout::OpenAddressing};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    HashSet<int> copy{s};
+    HashSet<int> moved{std::move(s)};
+
+    EXPECT_EQ(HashSetLayout::OpenAddressing, copy.layout());
+    EXPECT_EQ(100, copy.size());
+    EXPECT_EQ(100, moved.size());
+
+    HashSet<int> assigned{zeroHash<int>};
+    assigned = copy;
+
+    EXPECT_EQ(HashSetLayout::OpenAddressing, assigned.layout());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(copy.contains(i));
+        EXPECT_TRUE(moved.contains(i));
+        EXPECT_TRUE(assigned.contains(i));
+    }
+}
+
+
+TEST(HashSet_Tests, movedFromSetsKeepTheirLayoutAndStayUsable)
+{
+    for (HashSetLayout layout : {HashSetLayout::SeparateChaining, HashSetLayout::OpenAddressing})
+    {
+        HashSet<int> s{identityHash, layout};
+        s.add(1);
+
+        HashSet<int> moved{std::move(s)};
+
+        EXPECT_EQ(layout, s.layout());
+        EXPECT_EQ(0, s.size());
+        EXPECT_FALSE(s.contains(1));
+
+        int keys[] = {1, 2};
+        bool found[] = {true, true};
+        s.containsMany(keys, 2, found);
+        EXPECT_FALSE(found[0]);
+        EXPECT_FALSE(found[1]);
+
+        s.reserve(100);
+        EXPECT_EQ(layout, s.layout());
+
+        for (int i = 0; i < 50; ++i)
+        {
+            s.add(i);
+        }
+
+        HashSet<int> again{std::move(moved)};
+        moved.add(7);
+
+        HashSet<int> copy{s};
+
+        EXPECT_EQ(layout, copy.layout());
+        EXPECT_EQ(50, copy.size());
+        EXPECT_TRUE(copy.contains(49));
+        EXPECT_TRUE(moved.contains(7));
+        EXPECT_EQ(1, moved.size());
+        EXPECT_TRUE(again.contains(1));
+    }
+}
+
+
+TEST(HashSet_Tests, chainedCopiesKeepEveryElement)
+{
+    HashSet<int> s{zeroHash<int>};
+
+    for (int i = 0; i < 5; ++i)
+    {
+        s.add(i);
+    }
+
+    HashSet<int> copy{s};
+
+    EXPECT_EQ(5, copy.size());
+    EXPECT_EQ(5, copy.elementsAtIndex(0));
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(copy.contains(i));
+    }
+}
+
+
+TEST(HashSet_Tests, chainedResizingKeepsEveryElement)
+{
+    HashSet<int> s{zeroHash<int>};
+
+    for (int i = 0; i < 200; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(200, s.size());
+    EXPECT_EQ(200, s.elementsAtIndex(0));
+
+    for (int i = 0; i < 200; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(HashSet_Tests, reserveSizesTheArrayUpFront)
+{
+    HashSet<int> chained{identityHash};
+    HashSet<int> open{identityHash, HashSetLayout::OpenAddressing};
+
+    chained.add(170);
+    open.add(170);
+    chained.reserve(100);
+    open.reserve(100);
+
+    // 10 -> 21 -> 43 -> 87 -> 175, so 170 now hashes to its own index.
+    EXPECT_TRUE(chained.isElementAtIndex(170, 170));
+    EXPECT_TRUE(open.isElementAtIndex(170, 170));
+    EXPECT_EQ(1, chained.size());
+    EXPECT_EQ(1, open.size());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        chained.add(i);
+        open.add(i);
+    }
+
+    EXPECT_TRUE(chained.isElementAtIndex(170, 170));
+    EXPECT_TRUE(open.isElementAtIndex(170, 170));
+    EXPECT_EQ(1, chained.elementsAtIndex(99));
+}
+
+
+TEST(HashSet_Tests, resizingDoesNotRehashElements)
+{
+    unsigned int calls = 0;
+    auto countingHash = [&](const int& i) { ++calls; return static_cast<unsigned int>(i); };
+
+    HashSet<int> chained{countingHash};
+    HashSet<int> open{countingHash, HashSetLayout::OpenAddressing};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        chained.add(i);
+        open.add(i);
+    }
+
+    // Each add() hashes its element exactly once.
+    EXPECT_EQ(200, calls);
+}
+
+
+TEST(HashSet_Tests, canUseFunctionObjectAsHashFunctionType)
+{
+    HashSet<int, ModuloHash> s{ModuloHash{}};
+    s.add(3);
+    s.add(10);
+    s.add(4);
+
+    EXPECT_EQ(2, s.elementsAtIndex(3));
+    EXPECT_EQ(1, s.elementsAtIndex(4));
+    EXPECT_TRUE(s.isElementAtIndex(10, 3));
+
+    HashSet<int, ModuloHash> copy{s};
+    EXPECT_TRUE(copy.contains(10));
+}
+
+
+TEST(HashSet_Tests, stringHashAgreesWhetherWrappedOrNot)
+{
+    HashSet<std::string> wrapped{StringHash{}};
+    HashSet<std::string, StringHash> inlined{StringHash{}, HashSetLayout::OpenAddressing};
+
+    std::string words[] = {"A", "HELLO", "THERE", "BOO", "ABCDEFGH", "ABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+
+    for (const std::string& word : words)
+    {
+        wrapped.add(word);
+        inlined.add(word);
+    }
+
+    for (const std::string& word : words)
+    {
+        unsigned int index = StringHash{}(word) % 10;
+        EXPECT_TRUE(wrapped.isElementAtIndex(word, index));
+        EXPECT_TRUE(inlined.isElementAtIndex(word, index));
+    }
+
+    EXPECT_FALSE(inlined.contains("ABCDEFGHI"));
+    EXPECT_NE(StringHash{}("ABCDEFGH"), StringHash{}("ABCDEFGHI"));
+}
+
+
+TEST(HashSet_Tests, canLookUpStringViewsWithoutBuildingStrings)
+{
+    HashSet<std::string, StringHash> chained{StringHash{}};
+    HashSet<std::string, StringHash> open{StringHash{}, HashSetLayout::OpenAddressing};
+    HashSet<std::string> wrapped{StringHash{}};
+
+    for (const char* word : {"HELLO", "THERE", "BOO", "ABCDEFGHIJKLMNOPQRSTUVWXYZ"})
+    {
+        chained.add(word);
+        open.add(word);
+        wrapped.add(word);
+    }
+
+    std::string_view text{"BOOHELLOTHERE"};
+
+    EXPECT_EQ(StringHash{}(std::string{"HELLO"}), StringHash{}(text.substr(3, 5)));
+
+    EXPECT_TRUE(chained.contains(text.substr(3, 5)));
+    EXPECT_TRUE(open.contains(text.substr(0, 3)));
+    EXPECT_TRUE(wrapped.contains(text.substr(8)));
+    EXPECT_TRUE(open.contains(text.data() + 8, 5));
+    EXPECT_FALSE(chained.contains(text));
+    EXPECT_FALSE(open.contains(text.substr(0, 4)));
+    EXPECT_FALSE(wrapped.contains(text.data(), 2));
+}
+
+
+TEST(HashSet_Tests, containsManyAgreesWithContains)
+{
+    HashSet<int> chained{identityHash};
+    HashSet<int> open{identityHash, HashSetLayout::OpenAddressing};
+
+    for (int i = 0; i < 500; i += 7)
+    {
+        chained.add(i);
+        open.add(i);
+    }
+
+    int keys[100];
+    bool chainedFound[100];
+    bool openFound[100];
+
+    for (int i = 0; i < 100; ++i)
+    {
+        keys[i] = i * 5;
+    }
+
+    chained.containsMany(keys, 100, chainedFound);
+    open.containsMany(keys, 100, openFound);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(keys[i] % 7 == 0, chainedFound[i]);
+        EXPECT_EQ(keys[i] % 7 == 0, openFound[i]);
+    }
+}
+
+
+TEST(HashSet_Tests, containsManyTakesStringViews)
+{
+    HashSet<std::string, StringHash> s{StringHash{}, HashSetLayout::OpenAddressing};
+    s.add("HELLO");
+    s.add("BOO");
+
+    std::string_view keys[] = {"BOO", "HELLO", "HELL", ""};
+    bool found[4];
+
+    s.containsMany(keys, 4, found);
+
+    EXPECT_TRUE(found[0]);
+    EXPECT_TRUE(found[1]);
+    EXPECT_FALSE(found[2]);
+    EXPECT_FALSE(found[3]);
+}
+
+
+TEST(HashSet_Tests, looksUpKeysDirectlyOnlyWhenTheHashFunctionTakesThem)
+{
+    HashSet<std::string, StringHash> inlined{StringHash{}};
+    HashSet<std::string> wrapped{StringHash{}};
+    HashSet<int> ints{identityHash};
+
+    EXPECT_TRUE(inlined.looksUpKeysDirectly());
+    EXPECT_FALSE(wrapped.looksUpKeysDirectly());
+    EXPECT_TRUE(ints.looksUpKeysDirectly());
+}
+
+
+TEST(HashSet_Tests, memoryUsageGrowsWithTheArrayAndTheNodes)
+{
+    HashSet<int> chained{identityHash};
+    HashSet<int> open{identityHash, HashSetLayout::OpenAddressing};
+
+    std::size_t chainedEmpty = chained.memoryUsage();
+    std::size_t openEmpty = open.memoryUsage();
+
+    chained.add(1);
+    open.add(1);
+
+    // A chained set allocates a node for the element; an open-addressed
+    // one stores it in a slot it already had.
+    EXPECT_LT(chainedEmpty, chained.memoryUsage());
+    EXPECT_EQ(openEmpty, open.memoryUsage());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        chained.add(i);
+        open.add(i);
+    }
+
+    EXPECT_LT(openEmpty, open.memoryUsage());
+    EXPECT_LT(open.memoryUsage(), chained.memoryUsage());
+}
+
+
+TEST(HashSet_Tests, canAllocateNodesFromAnArena)
+{
+    HashSet<std::string, StringHash, ArenaNodeAllocator> s{StringHash{}};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    HashSet<std::string, StringHash, ArenaNodeAllocator> copy{s};
+    HashSet<std::string, StringHash, ArenaNodeAllocator> moved{std::move(s)};
+    HashSet<std::string, StringHash, ArenaNodeAllocator> assigned{StringHash{}};
+    assigned.add("GONE");
+    assigned = copy;
+
+    EXPECT_EQ(5000, copy.size());
+    EXPECT_EQ(5000, moved.size());
+    EXPECT_EQ(5000, assigned.size());
+    EXPECT_FALSE(assigned.contains("GONE"));
+
+    for (int i = 0; i < 5000; i += 10)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        EXPECT_TRUE(copy.contains(word));
+        EXPECT_TRUE(moved.contains(word));
+        EXPECT_TRUE(assigned.contains(word));
+    }
+}
@@ -0,0 +1,218 @@
+// LevenshteinAutomaton_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for LevenshteinAutomaton, and for searching a DAWGSet with
+// one through WordChecker::findSuggestionsWithin().
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DAWGSet.hpp"
+#include "DeletionIndex.hpp"
+#include "EditDistance.hpp"
+#include "HashSet.hpp"
+#include "LevenshteinAutomaton.hpp"
+#include "StringHash.hpp"
+#include "TestWords.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> randomWords(unsigned int count, unsigned int seed)
+    {
+        return TestWords::randomWords(count, seed, 0, 7, 'A', 'D');
+    }
+
+
+    LevenshteinAutomaton::State feed(const LevenshteinAutomaton& automaton, const std::string& s)
+    {
+        LevenshteinAutomaton::State state = automaton.start();
+        for (char c : s)
+            state = automaton.step(state, c);
+        return state;
+    }
+}
+
+
+TEST(LevenshteinAutomaton_Tests, matchesStringsWithinTheDistance)
+{
+    LevenshteinAutomaton automaton{"CAT", 1};
+
+    for (const char* s : {"CAT", "ACT", "CT", "CART", "BAT", "CA T"})
+        EXPECT_TRUE(automaton.isMatch(feed(automaton, s))) << s;
+
+    for (const char* s : {"", "TAC", "DOG", "CARTS", "AT T"})
+        EXPECT_FALSE(automaton.isMatch(feed(automaton, s))) << s;
+}
+
+
+TEST(LevenshteinAutomaton_Tests, distancesAgreeWithEditDistance)
+{
+    std::vector<std::string> words = randomWords(120, 31);
+
+    for (unsigned int maxDistance = 0; maxDistance <= 3; maxDistance++)
+    {
+        for (const std::string& word : words)
+        {
+            LevenshteinAutomaton automaton{word, maxDistance};
+
+            for (const std::string& other : words)
+            {
+                LevenshteinAutomaton::State state = feed(automaton, other);
+                unsigned int expected = std::min(editDistance(word, other), maxDistance + 1);
+
+                ASSERT_EQ(expected, automaton.distance(state)) << word << " " << other;
+                ASSERT_EQ(expected <= maxDistance, automaton.isMatch(state));
+            }
+        }
+    }
+}
+
+
+TEST(LevenshteinAutomaton_Tests, cannotMatchOnlyWhenNoExtensionCould)
+{
+    std::vector<std::string> words = randomWords(60, 32);
+    std::vector<std::string> extensions = randomWords(30, 33);
+
+    for (const std::string& word : words)
+    {
+        LevenshteinAutomaton automaton{word, 1};
+
+        for (const std::string& prefix : words)
+        {
+            if (automaton.canMatch(feed(automaton, prefix)))
+                continue;
+
+            for (const std::string& extension : extensions)
+            {
+                std::string s = prefix + extension;
+                ASSERT_FALSE(automaton.isMatch(feed(automaton, s))) << word << " " << s;
+            }
+        }
+    }
+}
+
+
+TEST(LevenshteinAutomaton_Tests, searchingADAWGSetFindsEveryWordWithinAnyDistance)
+{
+    std::vector<std::string> dictionary = randomWords(800, 34);
+    DAWGSet dawg{dictionary};
+    WordChecker checker{dawg};
+
+    for (const std::string& word : randomWords(60, 35))
+    {
+        for (unsigned int distance = 0; distance <= 4; distance++)
+        {
+            std::vector<std::string> expected;
+            if (!dawg.contains(word))
+                expected = TestWords::wordsWithin(dictionary, word, distance);
+
+            EXPECT_EQ(expected, checker.findSuggestionsWithin(word, distance))
+                << word << " " << distance;
+        }
+    }
+}
+
+
+TEST(LevenshteinAutomaton_Tests, searchingADAWGSetAgreesWithADeletionIndex)
+{
+    std::vector<std::string> dictionary = randomWords(2000, 36);
+
+    DAWGSet dawg{dictionary};
+    HashSet<std::string, StringHash> hashSet{StringHash{}};
+    DeletionIndex index;
+
+    for (const std::string& word : dictionary)
+    {
+        hashSet.add(word);
+        index.add(word);
+    }
+
+    WordChecker automatonChecker{dawg};
+    WordChecker indexChecker{hashSet, index};
+
+    for (const std::string& word : randomWords(100, 37))
+    {
+        for (unsigned int distance = 1; distance <= 2; distance++)
+        {
+            EXPECT_EQ(
+                indexChecker.findSuggestionsWithin(word, distance),
+                automatonChecker.findSuggestionsWithin(word, distance)) << word;
+        }
+    }
+}
+
+
+TEST(LevenshteinAutomaton_Tests, aDAWGSetIsSearchedPastWhatItsIndexCanSearch)
+{
+    std::vector<std::string> dictionary = randomWords(800, 38);
+
+    DAWGSet dawg{dictionary};
+    DeletionIndex index{1};
+
+    for (const std::string& word : dictionary)
+        index.add(word);
+
+    WordChecker checker{dawg, index};
+
+    for (const std::string& word : randomWords(40, 39))
+    {
+        if (dawg.contains(word))
+            continue;
+
+        for (unsigned int distance = 1; distance <= 3; distance++)
+        {
+            EXPECT_EQ(
+                TestWords::wordsWithin(dictionary, word, distance),
+                checker.findSuggestionsWithin(word, distance)) << word << " " << distance;
+        }
+    }
+}
+
+
+TEST(LevenshteinAutomaton_Tests, distanceOneIncludesEverythingTheFiveAlgorithmsFind)
+{
+    const char* dictionary[] = {
+        "BAT", "CART", "CAT", "CA T", "CAST", "AT", "ACTS",
+        "A", "XA", "AAX", "AXA", "AAA", "TAC", "ACT"};
+
+    HashSet<std::string, StringHash> hashSet{StringHash{}};
+    DAWGSet dawg;
+
+    for (const char* word : dictionary)
+    {
+        hashSet.add(word);
+        dawg.add(word);
+    }
+
+    WordChecker probing{hashSet};
+    WordChecker automaton{dawg};
+
+    for (const char* word : {"CAAT", "CAT ", "CTA", "AX", "AAAA", "ATC", "CATX"})
+    {
+        std::vector<std::string> expected = probing.findSuggestions(word);
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<std::string> within = automaton.findSuggestionsWithin(word, 1);
+        std::sort(within.begin(), within.end());
+
+        EXPECT_TRUE(std::includes(within.begin(), within.end(), expected.begin(), expected.end()))
+            << word;
+    }
+
+    // Swapping the last two characters of "CTA" gives "CAT".
+    std::vector<std::string> expected{"CAT"};
+    EXPECT_EQ(expected, automaton.findSuggestionsWithin("CTA", 1));
+
+    // Replacing a character with a space is one edit, too, but not one of
+    // the five algorithms.
+    expected = {"CA T", "CART", "CAST", "CAT"};
+    EXPECT_EQ(expected, automaton.findSuggestionsWithin("CAXT", 1));
+
+    expected = {"CAT", "CART", "CAST"};
+    EXPECT_EQ(expected, probing.findSuggestions("CAXT"));
+}
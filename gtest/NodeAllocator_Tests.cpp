@@ -0,0 +1,80 @@
+// NodeAllocator_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the node allocators.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <gtest/gtest.h>
+#include "NodeAllocator.hpp"
+
+
+namespace
+{
+    bool isAligned(void* p)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignof(std::max_align_t) == 0;
+    }
+}
+
+
+TEST(NodeAllocator_Tests, arenaPlacesConsecutiveNodesTogether)
+{
+    ArenaNodeAllocator a;
+
+    char* first = static_cast<char*>(a.allocate(40));
+    char* second = static_cast<char*>(a.allocate(40));
+
+    EXPECT_TRUE(isAligned(first));
+    EXPECT_TRUE(isAligned(second));
+    EXPECT_GE(second - first, 40);
+    EXPECT_LE(second - first, 40 + static_cast<std::ptrdiff_t>(alignof(std::max_align_t)));
+}
+
+
+TEST(NodeAllocator_Tests, arenaHandlesManySmallAndSomeLargeAllocations)
+{
+    ArenaNodeAllocator a;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        void* p = a.allocate(24 + i % 50);
+        EXPECT_TRUE(isAligned(p));
+        std::memset(p, 0xAB, 24 + i % 50);
+
+        if (i % 1000 == 0)
+        {
+            void* big = a.allocate(ArenaNodeAllocator::BLOCK_SIZE);
+            EXPECT_TRUE(isAligned(big));
+            std::memset(big, 0xCD, ArenaNodeAllocator::BLOCK_SIZE);
+        }
+    }
+
+    a.reset();
+
+    void* p = a.allocate(16);
+    EXPECT_TRUE(isAligned(p));
+}
+
+
+TEST(NodeAllocator_Tests, movingAnArenaTransfersItsMemory)
+{
+    ArenaNodeAllocator a;
+    int* p = static_cast<int*>(a.allocate(sizeof(int)));
+    *p = 46;
+
+    ArenaNodeAllocator b{std::move(a)};
+    EXPECT_EQ(46, *p);
+
+    ArenaNodeAllocator c;
+    c = std::move(b);
+    EXPECT_EQ(46, *p);
+
+    ArenaNodeAllocator copy{c};
+    int* q = static_cast<int*>(copy.allocate(sizeof(int)));
+    EXPECT_NE(p, q);
+}
@@ -0,0 +1,436 @@
+// SkipListSet_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the SkipListSet functionality beyond what the
+// sanity-checking tests cover.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "NodeAllocator.hpp"
+#include "SkipListSet.hpp"
+#include "StringHash.hpp"
+
+
+namespace
+{
+    // A ModuloLevelTester places each element e on (e % 4) + 1 levels, so
+    // tests can know exactly where every element will be.
+    class ModuloLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        bool shouldOccupyNextLevel(const int& element) override
+        {
+            if (element != current)
+            {
+                current = element;
+                flips = 0;
+            }
+
+            return ++flips <= element % 4;
+        }
+
+        std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<ModuloLevelTester>();
+        }
+
+    private:
+        int current = -1;
+        int flips = 0;
+    };
+
+
+    // A Counted is an int that counts how many times any Counted has been
+    // copied.
+    struct Counted
+    {
+        static inline int copies = 0;
+
+        int value;
+
+        Counted(int value)
+            : value{value}
+        {
+        }
+
+        Counted(const Counted& other)
+            : value{other.value}
+        {
+            ++copies;
+        }
+
+        bool operator==(const Counted& other) const
+        {
+            return value == other.value;
+        }
+
+        bool operator<(const Counted& other) const
+        {
+            return value < other.value;
+        }
+    };
+
+
+    template <typename ElementType>
+    class AlwaysGrowLevelTester : public SkipListLevelTester<ElementType>
+    {
+    public:
+        bool shouldOccupyNextLevel(const ElementType& /* element */) override
+        {
+            return true;
+        }
+
+        std::unique_ptr<SkipListLevelTester<ElementType>> clone() override
+        {
+            return std::make_unique<AlwaysGrowLevelTester>();
+        }
+    };
+}
+
+
+TEST(SkipListSet_Tests, elementsOccupyTheLevelsTheTesterChooses)
+{
+    SkipListSet<int> s{std::make_unique<ModuloLevelTester>()};
+
+    for (int i = 39; i >= 0; --i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(40, s.size());
+    EXPECT_EQ(4, s.levelCount());
+    EXPECT_EQ(40, s.elementsOnLevel(0));
+    EXPECT_EQ(30, s.elementsOnLevel(1));
+    EXPECT_EQ(20, s.elementsOnLevel(2));
+    EXPECT_EQ(10, s.elementsOnLevel(3));
+    EXPECT_EQ(0, s.elementsOnLevel(4));
+
+    for (int i = 0; i < 40; ++i)
+    {
+        for (unsigned int level = 0; level < 6; ++level)
+        {
+            EXPECT_EQ(level <= static_cast<unsigned int>(i % 4), s.isElementOnLevel(i, level));
+        }
+    }
+
+    EXPECT_FALSE(s.isElementOnLevel(40, 0));
+}
+
+
+TEST(SkipListSet_Tests, addingDuplicatesHasNoEffect)
+{
+    SkipListSet<int> s{std::make_unique<ModuloLevelTester>()};
+    s.add(3);
+    s.add(1);
+    s.add(3);
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_EQ(4, s.levelCount());
+    EXPECT_EQ(1, s.elementsOnLevel(3));
+}
+
+
+TEST(SkipListSet_Tests, levelsAreCappedAtTheMaximum)
+{
+    SkipListSet<int> s{std::make_unique<AlwaysGrowLevelTester<int>>()};
+    s.add(1);
+    s.add(2);
+
+    EXPECT_EQ(SkipListSet<int>::MAX_LEVELS, s.levelCount());
+    EXPECT_TRUE(s.isElementOnLevel(2, SkipListSet<int>::MAX_LEVELS - 1));
+    EXPECT_TRUE(s.contains(1));
+    EXPECT_TRUE(s.contains(2));
+    EXPECT_FALSE(s.contains(3));
+}
+
+
+TEST(SkipListSet_Tests, containsAgreesWithWhatWasAdded)
+{
+    SkipListSet<int> s;
+    std::vector<bool> added(2000, false);
+
+    for (int i = 0; i < 2000; i += 3)
+    {
+        int element = (i * 7919) % 2000;
+        s.add(element);
+        added[element] = true;
+    }
+
+    EXPECT_EQ(667, s.size());
+    EXPECT_EQ(667, s.elementsOnLevel(0));
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(added[i], s.contains(i));
+    }
+
+    EXPECT_FALSE(s.contains(-1));
+    EXPECT_FALSE(s.contains(2000));
+}
+
+
+TEST(SkipListSet_Tests, canLookUpStringViewsWithoutBuildingStrings)
+{
+    SkipListSet<std::string> s;
+    s.add("HELLO");
+    s.add("THERE");
+    s.add("BOO");
+
+    std::string_view text{"BOOHELLOTHERE"};
+
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_TRUE(s.contains(text.substr(3, 5)));
+    EXPECT_TRUE(s.contains(text.data() + 8, 5));
+    EXPECT_FALSE(s.contains(text));
+    EXPECT_FALSE(s.contains(text.data(), 2));
+    EXPECT_TRUE(s.contains("HELLO"));
+}
+
+
+TEST(SkipListSet_Tests, copiesHaveTheSameLevels)
+{
+    SkipListSet<int> s{std::make_unique<ModuloLevelTester>()};
+
+    for (int i = 0; i < 20; ++i)
+    {
+        s.add(i);
+    }
+
+    SkipListSet<int> copy{s};
+    s.add(100);
+
+    EXPECT_EQ(20, copy.size());
+    EXPECT_FALSE(copy.contains(100));
+
+    for (unsigned int level = 0; level < 4; ++level)
+    {
+        EXPECT_EQ(s.elementsOnLevel(level) - (level == 0 ? 1 : 0), copy.elementsOnLevel(level));
+    }
+
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(copy.isElementOnLevel(i, i % 4));
+        EXPECT_FALSE(copy.isElementOnLevel(i, i % 4 + 1));
+    }
+
+    copy.add(23);
+
+    EXPECT_TRUE(copy.isElementOnLevel(23, 3));
+
+    SkipListSet<int> assigned;
+    assigned.add(-1);
+    assigned = copy;
+
+    EXPECT_EQ(21, assigned.size());
+    EXPECT_FALSE(assigned.contains(-1));
+    EXPECT_TRUE(assigned.contains(23));
+}
+
+
+TEST(SkipListSet_Tests, movesTakeTheNodes)
+{
+    SkipListSet<std::string> s;
+    s.add("CAT");
+    s.add("DOG");
+
+    SkipListSet<std::string> moved{std::move(s)};
+
+    EXPECT_EQ(2, moved.size());
+    EXPECT_TRUE(moved.contains("CAT"));
+
+    SkipListSet<std::string> assigned;
+    assigned.add("OLD");
+    assigned = std::move(moved);
+
+    EXPECT_EQ(2, assigned.size());
+    EXPECT_FALSE(assigned.contains("OLD"));
+
+    assigned.add("EEL");
+
+    EXPECT_EQ(3, assigned.size());
+    EXPECT_TRUE(assigned.contains("EEL"));
+}
+
+
+TEST(SkipListSet_Tests, movedFromSetsAreEmptyAndStillUsable)
+{
+    SkipListSet<std::string> s;
+    s.add("CAT");
+    s.add("DOG");
+
+    SkipListSet<std::string> moved{std::move(s)};
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_FALSE(s.contains("CAT"));
+    EXPECT_EQ(0, s.elementsOnLevel(0));
+
+    SkipListSet<std::string> copy{s};
+    EXPECT_EQ(0, copy.size());
+
+    s.add("EEL");
+    s.add("CAT");
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains("EEL"));
+    EXPECT_TRUE(s.contains("CAT"));
+    EXPECT_FALSE(s.contains("DOG"));
+    EXPECT_TRUE(moved.contains("DOG"));
+
+    copy = std::move(moved);
+    moved = s;
+
+    EXPECT_EQ(2, moved.size());
+    EXPECT_TRUE(moved.contains("EEL"));
+    EXPECT_EQ(2, copy.size());
+    EXPECT_TRUE(copy.contains("DOG"));
+}
+
+
+TEST(SkipListSet_Tests, canAllocateNodesFromAnArena)
+{
+    SkipListSet<std::string, ArenaNodeAllocator> s;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    SkipListSet<std::string, ArenaNodeAllocator> copy{s};
+    SkipListSet<std::string, ArenaNodeAllocator> moved{std::move(s)};
+
+    EXPECT_EQ(5000, copy.size());
+    EXPECT_EQ(5000, moved.size());
+
+    for (int i = 0; i < 5000; i += 10)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        EXPECT_TRUE(copy.contains(word));
+        EXPECT_TRUE(moved.contains(word));
+    }
+
+    SkipListSet<int, ArenaNodeAllocator> ints;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ints.add(i);
+    }
+
+    EXPECT_EQ(1000, ints.elementsOnLevel(0));
+}
+
+
+TEST(SkipListSet_Tests, defaultLevelsForFlipsOncePerLevel)
+{
+    ModuloLevelTester tester;
+
+    EXPECT_EQ(1, tester.levelsFor(4, 32));
+    EXPECT_EQ(3, tester.levelsFor(6, 32));
+    EXPECT_EQ(4, tester.levelsFor(7, 32));
+    EXPECT_EQ(2, tester.levelsFor(11, 2));
+}
+
+
+TEST(SkipListSet_Tests, hashLevelTesterIsDeterministic)
+{
+    using Tester = HashSkipListLevelTester<std::string, StringHash>;
+
+    SkipListSet<std::string> forward{std::make_unique<Tester>(StringHash{})};
+    SkipListSet<std::string> backward{std::make_unique<Tester>(StringHash{})};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        forward.add("WORD" + std::to_string(i));
+        backward.add("WORD" + std::to_string(999 - i));
+    }
+
+    ASSERT_EQ(forward.levelCount(), backward.levelCount());
+
+    for (unsigned int level = 0; level < forward.levelCount(); ++level)
+    {
+        EXPECT_EQ(forward.elementsOnLevel(level), backward.elementsOnLevel(level));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+
+        for (unsigned int level = 0; level < forward.levelCount(); ++level)
+        {
+            EXPECT_EQ(forward.isElementOnLevel(word, level), backward.isElementOnLevel(word, level));
+        }
+    }
+}
+
+
+TEST(SkipListSet_Tests, hashLevelTesterHalvesEachLevel)
+{
+    // Even an identity hash, after mixing, should put about half of the
+    // elements on each level above the one below it.
+    SkipListSet<int> s{std::make_unique<HashSkipListLevelTester<int>>([](int i) { return i; })};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_NEAR(5000, s.elementsOnLevel(1), 300);
+    EXPECT_NEAR(2500, s.elementsOnLevel(2), 250);
+    EXPECT_NEAR(1250, s.elementsOnLevel(3), 200);
+}
+
+
+TEST(SkipListSet_Tests, hashLevelTesterAnswersTheSameWhateverItWasAskedBefore)
+{
+    HashSkipListLevelTester<int> tester{[](int i) { return i * 31; }};
+
+    for (int i = 0; i < 200; ++i)
+    {
+        bool occupies = tester.levelsFor(i, 32) > 1;
+
+        EXPECT_EQ(occupies, tester.shouldOccupyNextLevel(i));
+        EXPECT_EQ(occupies, tester.shouldOccupyNextLevel(i));
+        EXPECT_EQ(tester.levelsFor(i, 32), tester.levelsFor(i, 32));
+        EXPECT_EQ(std::min(tester.levelsFor(i, 32), 3u), tester.levelsFor(i, 3));
+    }
+
+    std::unique_ptr<SkipListLevelTester<int>> clone = tester.clone();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        EXPECT_EQ(tester.levelsFor(i, 32), clone->levelsFor(i, 32));
+    }
+}
+
+
+TEST(SkipListSet_Tests, elementsAreCopiedOnlyIntoTheirNodes)
+{
+    SkipListSet<Counted> s{std::make_unique<AlwaysGrowLevelTester<Counted>>()};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(Counted{i});
+    }
+
+    EXPECT_EQ(100, Counted::copies);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        s.contains(Counted{i});
+        s.add(Counted{i % 100});
+        s.isElementOnLevel(Counted{i}, 3);
+    }
+
+    EXPECT_EQ(100, Counted::copies);
+
+    SkipListSet<Counted> copy{s};
+
+    EXPECT_EQ(200, Counted::copies);
+    EXPECT_EQ(SkipListSet<Counted>::MAX_LEVELS, copy.levelCount());
+}
@@ -0,0 +1,288 @@
+// WordChecker_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WordChecker functionality beyond what the
+// sanity-checking tests cover.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "BKTree.hpp"
+#include "DeletionIndex.hpp"
+#include "HashSet.hpp"
+#include "Set.hpp"
+#include "StringHash.hpp"
+#include "VectorSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // A RecordingSet contains nothing, but remembers every element that
+    // it was asked about, in order.
+    class RecordingSet : public Set<std::string>
+    {
+    public:
+        bool isImplemented() const noexcept override
+        {
+            return true;
+        }
+
+        void add(const std::string& /* element */) override
+        {
+        }
+
+        bool contains(const std::string& element) const override
+        {
+            lookups.push_back(element);
+            return false;
+        }
+
+        unsigned int size() const noexcept override
+        {
+            return 0;
+        }
+
+        mutable std::vector<std::string> lookups;
+    };
+
+
+    std::vector<std::string> expectedCandidates(const std::string& word)
+    {
+        std::vector<std::string> candidates;
+
+        for (unsigned int i = 0; i + 1 < word.size(); ++i)
+        {
+            std::string s = word;
+            std::swap(s[i], s[i + 1]);
+            candidates.push_back(s);
+        }
+
+        for (unsigned int i = 0; i <= word.size(); ++i)
+        {
+            for (char c = 'A'; c <= 'Z'; ++c)
+            {
+                candidates.push_back(word.substr(0, i) + c + word.substr(i));
+            }
+        }
+
+        for (unsigned int i = 0; i < word.size(); ++i)
+        {
+            candidates.push_back(word.substr(0, i) + word.substr(i + 1));
+        }
+
+        for (unsigned int i = 0; i < word.size(); ++i)
+        {
+            for (char c = 'A'; c <= 'Z'; ++c)
+            {
+                if (c != word[i])
+                {
+                    candidates.push_back(word.substr(0, i) + c + word.substr(i + 1));
+                }
+            }
+        }
+
+        for (unsigned int i = 0; i <= word.size(); ++i)
+        {
+            candidates.push_back(word.substr(0, i) + ' ' + word.substr(i));
+        }
+
+        return candidates;
+    }
+}
+
+
+TEST(WordChecker_Tests, probesEveryCandidateInStrategyOrder)
+{
+    for (std::string word : {"", "A", "AB", "HELLO", "SPELLCHECKING"})
+    {
+        RecordingSet set;
+        WordChecker checker{set};
+
+        checker.findSuggestions(word);
+
+        std::vector<std::string> expected = expectedCandidates(word);
+        expected.insert(expected.begin(), word);
+
+        EXPECT_EQ(expected, set.lookups);
+    }
+}
+
+
+TEST(WordChecker_Tests, suggestionsFollowStrategyOrderWithoutDuplicates)
+{
+    VectorSet<std::string> set;
+    set.add("BAT");
+    set.add("CART");
+    set.add("CAT");
+    set.add("CA T");
+    set.add("CAST");
+    set.add("AT");
+    set.add("ACTS");
+
+    WordChecker checker{set};
+
+    std::vector<std::string> suggestions = checker.findSuggestions("CAAT");
+    std::vector<std::string> expected{"CAT", "CART", "CAST"};
+
+    EXPECT_EQ(expected, suggestions);
+
+    suggestions = checker.findSuggestions("CAT ");
+    expected = {"CA T", "CAT"};
+
+    EXPECT_EQ(expected, suggestions);
+
+    suggestions = checker.findSuggestions("ACT");
+    expected = {"CAT", "ACTS", "AT"};
+
+    EXPECT_EQ(expected, suggestions);
+}
+
+
+TEST(WordChecker_Tests, noSuggestionsForCorrectWords)
+{
+    VectorSet<std::string> set;
+    set.add("CAT");
+    set.add("BAT");
+
+    WordChecker checker{set};
+
+    EXPECT_TRUE(checker.findSuggestions("CAT").empty());
+}
+
+
+TEST(WordChecker_Tests, manyNeighborsAreEachSuggestedOnce)
+{
+    VectorSet<std::string> set;
+    set.add("A");
+    set.add("XA");
+    set.add("AAX");
+    set.add("AXA");
+    set.add("AAA");
+
+    for (char c = 'A'; c <= 'Z'; ++c)
+    {
+        if (c != 'X')
+        {
+            set.add(std::string{"A"} + c);
+        }
+    }
+
+    WordChecker checker{set};
+
+    // Inserting an A at either of the first two positions gives "AAX",
+    // and deleting any character of "AAAA" gives "AAA".
+    std::vector<std::string> suggestions = checker.findSuggestions("AX");
+    std::vector<std::string> expected{"XA", "AAX", "AXA", "A"};
+
+    for (char c = 'A'; c <= 'Z'; ++c)
+    {
+        if (c != 'X')
+        {
+            expected.push_back(std::string{"A"} + c);
+        }
+    }
+
+    EXPECT_EQ(expected, suggestions);
+
+    suggestions = checker.findSuggestions("AAAA");
+    expected = {"AAA"};
+
+    EXPECT_EQ(expected, suggestions);
+}
+
+
+TEST(WordChecker_Tests, batchedLookupsFindTheSameSuggestions)
+{
+    const char* dictionary[] = {
+        "BAT", "CART", "CAT", "CA T", "CAST", "AT", "ACTS", "A", "XA", "AAX", "AXA", "AAA"};
+
+    VectorSet<std::string> vectorSet;
+    HashSet<std::string, StringHash> chained{StringHash{}};
+    HashSet<std::string, StringHash> open{StringHash{}, HashSetLayout::OpenAddressing};
+    AVLSet<std::string> avl;
+
+    for (const char* word : dictionary)
+    {
+        vectorSet.add(word);
+        chained.add(word);
+        open.add(word);
+        avl.add(word);
+    }
+
+    WordChecker reference{vectorSet};
+    WordChecker chainedChecker{chained};
+    WordChecker openChecker{open};
+    WordChecker avlChecker{avl};
+
+    for (const char* word : {"CAAT", "CAT ", "ACT", "AX", "AAAA", "QQQQQQQQQQQQQQQQQQQQ", ""})
+    {
+        std::vector<std::string> expected = reference.findSuggestions(word);
+
+        EXPECT_EQ(expected, chainedChecker.findSuggestions(word));
+        EXPECT_EQ(expected, openChecker.findSuggestions(word));
+        EXPECT_EQ(expected, avlChecker.findSuggestions(word));
+    }
+}
+
+
+TEST(WordChecker_Tests, indexModeFindsTheSameSuggestionsNearestFirst)
+{
+    const char* dictionary[] = {
+        "BAT", "CART", "CAT", "CAST", "AT", "ACTS", "A", "XA", "AAX", "AXA", "AAA"};
+
+    VectorSet<std::string> set;
+    BKTree tree;
+
+    for (const char* word : dictionary)
+    {
+        set.add(word);
+        tree.add(word);
+    }
+
+    WordChecker probing{set, tree};
+    WordChecker indexed{set, tree, SuggestionMode::Index};
+
+    for (const char* word : {"CAAT", "ACT", "AX", "AAAA", "QQQQQQQQQQQQQQQQQQQQ", "", "CAT"})
+    {
+        std::vector<std::string> expected = probing.findSuggestions(word);
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<std::string> suggestions = indexed.findSuggestions(word);
+        std::sort(suggestions.begin(), suggestions.end());
+        EXPECT_EQ(expected, suggestions);
+    }
+
+    std::vector<std::string> expected{"CAT", "ACTS", "AT"};
+    EXPECT_EQ(expected, probing.findSuggestions("ACT"));
+
+    expected = {"ACTS", "AT", "CAT"};
+    EXPECT_EQ(expected, indexed.findSuggestions("ACT"));
+}
+
+
+TEST(WordChecker_Tests, indexModeProbesWhenTheIndexCantSearchOneEdit)
+{
+    VectorSet<std::string> set;
+    DeletionIndex index{0};
+
+    for (const char* word : {"BAT", "CART", "CAT", "CAST", "AT", "ACTS"})
+    {
+        set.add(word);
+        index.add(word);
+    }
+
+    WordChecker probing{set};
+    WordChecker indexed{set, index, SuggestionMode::Index};
+
+    for (const char* word : {"CAAT", "ACT", "AX", "CAT"})
+    {
+        EXPECT_EQ(probing.findSuggestions(word), indexed.findSuggestions(word));
+    }
+
+    EXPECT_FALSE(indexed.findSuggestions("ACT").empty());
+}
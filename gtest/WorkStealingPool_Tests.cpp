@@ -0,0 +1,75 @@
+// WorkStealingPool_Tests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WorkStealingPool.
+
+#include <atomic>
+#include <memory>
+#include <gtest/gtest.h>
+#include "WorkStealingPool.hpp"
+
+
+TEST(WorkStealingPool_Tests, runsEveryTaskExactlyOnce)
+{
+    for (unsigned int threadCount : {1u, 2u, 4u})
+    {
+        WorkStealingPool pool{threadCount};
+
+        EXPECT_EQ(threadCount, pool.threadCount());
+
+        for (unsigned int taskCount : {0u, 1u, 3u, 1000u})
+        {
+            std::unique_ptr<std::atomic<int>[]> runs{new std::atomic<int>[taskCount + 1]};
+
+            for (unsigned int i = 0; i <= taskCount; ++i)
+            {
+                runs[i].store(0);
+            }
+
+            pool.run(taskCount, [&](unsigned int task) { runs[task].fetch_add(1); });
+
+            for (unsigned int i = 0; i < taskCount; ++i)
+            {
+                EXPECT_EQ(1, runs[i].load());
+            }
+
+            EXPECT_EQ(0, runs[taskCount].load());
+        }
+    }
+}
+
+
+TEST(WorkStealingPool_Tests, idleThreadsStealFromBusyOnes)
+{
+    // The first task is given to the calling thread and takes until every
+    // other task has run, which can only happen if the helper steals the
+    // rest of the calling thread's tasks.
+    WorkStealingPool pool{2};
+    std::atomic<unsigned int> done{0};
+
+    pool.run(
+        100,
+        [&](unsigned int task)
+        {
+            if (task == 0)
+            {
+                while (done.load() < 99)
+                {
+                }
+            }
+
+            done.fetch_add(1);
+        });
+
+    EXPECT_EQ(100, done.load());
+}
+
+
+TEST(WorkStealingPool_Tests, zeroMeansOneThreadPerCore)
+{
+    WorkStealingPool pool;
+
+    EXPECT_GE(pool.threadCount(), 1);
+}